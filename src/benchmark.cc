@@ -0,0 +1,1064 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <malloc.h>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "s21_containers.h"
+#include "s21_containersplus.h"
+
+namespace {
+thread_local size_t allocations = 0;
+// Heap bytes held by this thread, including allocator slack.
+thread_local long long live_bytes = 0;
+}  // namespace
+
+void* operator new(size_t size) {
+  ++allocations;
+  if (void* ptr = std::malloc(size ? size : 1)) {
+    live_bytes += malloc_usable_size(ptr);
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+// Not inlined, or GCC pairs the free with the caller's new expression and
+// reports a mismatch.
+__attribute__((noinline)) void operator delete(void* ptr) noexcept {
+  if (ptr) live_bytes -= malloc_usable_size(ptr);
+  std::free(ptr);
+}
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+volatile size_t sink;
+
+template <class F>
+double BestSeconds(int repeats, F&& body) {
+  double best = 1e100;
+  for (int i = 0; i < repeats; ++i) {
+    auto start = Clock::now();
+    body();
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+void ReportThroughput(const char* name, double seconds, double bytes) {
+  std::printf("  %-36s %9.3f ms %8.2f GB/s\n", name, seconds * 1e3,
+              bytes / seconds / 1e9);
+}
+
+template <class T>
+void BenchSimdType(const char* type, size_t n) {
+  s21::Vector<T> vec(n);
+  for (size_t i = 0; i < n; ++i) vec[i] = (T)((i * 2654435761u) % 100000);
+  const T* first = vec.data();
+  const T* last = first + n;
+  const T missing = (T)-1;
+  double bytes = (double)n * sizeof(T);
+  char name[64];
+  auto report = [&](const char* op, double seconds) {
+    std::snprintf(name, sizeof(name), "%s %s", type, op);
+    ReportThroughput(name, seconds, bytes);
+  };
+
+  report("std::find", BestSeconds(5, [&] {
+           sink = std::find(first, last, missing) - first;
+         }));
+  report("s21::find", BestSeconds(5, [&] {
+           sink = s21::simd::Find(first, n, missing);
+         }));
+  report("std::count", BestSeconds(5, [&] {
+           sink = std::count(first, last, (T)7);
+         }));
+  report("s21::count", BestSeconds(5, [&] { sink = s21::count(vec, (T)7); }));
+  report("std::min_element", BestSeconds(5, [&] {
+           sink = (size_t)*std::min_element(first, last);
+         }));
+  report("s21::min", BestSeconds(5, [&] { sink = (size_t)s21::min(vec); }));
+  report("std::max_element", BestSeconds(5, [&] {
+           sink = (size_t)*std::max_element(first, last);
+         }));
+  report("s21::max", BestSeconds(5, [&] { sink = (size_t)s21::max(vec); }));
+  report("std::accumulate", BestSeconds(5, [&] {
+           sink = (size_t)std::accumulate(first, last,
+                                          s21::simd::SumType<T>(0));
+         }));
+  report("s21::sum", BestSeconds(5, [&] { sink = (size_t)s21::sum(vec); }));
+}
+
+void BenchSimd() {
+  const char* levels[] = {"scalar", "sse2", "avx2"};
+  std::printf("simd kernels, dispatch level: %s\n",
+              levels[(int)s21::simd::ActiveLevel()]);
+  BenchSimdType<int32_t>("int32", size_t(1) << 24);
+  BenchSimdType<float>("float", size_t(1) << 24);
+}
+
+template <class Container>
+void BenchSmallSize(const char* name, int elements, int rounds) {
+  size_t before = allocations;
+  double seconds = BestSeconds(3, [&] {
+    for (int r = 0; r < rounds; ++r) {
+      Container tags;
+      for (int i = 0; i < elements; ++i) tags.push_back(i);
+      sink = tags.size();
+    }
+  });
+  double allocs = (double)(allocations - before) / (3.0 * rounds);
+  std::printf("  %-24s %4d %10.2f %10.1f\n", name, elements, allocs,
+              seconds * 1e9 / rounds);
+}
+
+void BenchSmallVector() {
+  const int rounds = 200000;
+  std::printf("small vectors: elements, allocations and ns per container\n");
+  for (int elements : {0, 1, 2, 4, 8, 12, 16}) {
+    BenchSmallSize<std::vector<int>>("std::vector<int>", elements, rounds);
+    BenchSmallSize<s21::Vector<int>>("s21::Vector<int>", elements, rounds);
+    BenchSmallSize<s21::SmallVector<int, 8>>("s21::SmallVector<int,8>",
+                                             elements, rounds);
+  }
+}
+
+void FillRandom(s21::Vector<uint32_t>& vec, uint32_t seed) {
+  uint32_t state = seed;
+  for (size_t i = 0; i < vec.size(); ++i) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    vec[i] = state;
+  }
+}
+
+void BenchParallelSort() {
+  const size_t n = size_t(1) << 24;
+  s21::Vector<uint32_t> vec(n);
+  unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+  std::printf("parallel algorithms on %zu uint32, threads / ms / speedup\n",
+              n);
+  double fill = BestSeconds(3, [&] { FillRandom(vec, 1); });
+  double copy_out = BestSeconds(3, [&] {
+    FillRandom(vec, 1);
+    std::vector<uint32_t> copy(vec.data(), vec.data() + n);
+    std::sort(copy.begin(), copy.end());
+    std::copy(copy.begin(), copy.end(), vec.data());
+  });
+  std::printf("  %-22s %4d %10.1f\n", "copy to std::vector", 1,
+              (copy_out - fill) * 1e3);
+  double base_sort = 0, base_stable = 0, base_reduce = 0;
+  for (unsigned threads = 1;; threads = std::min(threads * 2, cores)) {
+    s21::execution::parallel_policy policy{threads};
+    double sorted = BestSeconds(3, [&] {
+                      FillRandom(vec, 1);
+                      s21::sort(policy, vec);
+                    }) -
+                    fill;
+    double stable = BestSeconds(3, [&] {
+                      FillRandom(vec, 1);
+                      s21::stable_sort(policy, vec);
+                    }) -
+                    fill;
+    double reduced = BestSeconds(
+        3, [&] { sink = s21::reduce(policy, vec, uint64_t(0)); });
+    if (threads == 1) {
+      base_sort = sorted;
+      base_stable = stable;
+      base_reduce = reduced;
+    }
+    std::printf("  %-22s %4u %10.1f %8.2fx\n", "s21::sort", threads,
+                sorted * 1e3, base_sort / sorted);
+    std::printf("  %-22s %4u %10.1f %8.2fx\n", "s21::stable_sort", threads,
+                stable * 1e3, base_stable / stable);
+    std::printf("  %-22s %4u %10.1f %8.2fx\n", "s21::reduce", threads,
+                reduced * 1e3, base_reduce / reduced);
+    if (threads == cores) break;
+  }
+  // Dominated by handing the chunks to workers rather than by the sums.
+  s21::Vector<uint32_t> small(size_t(1) << 17);
+  FillRandom(small, 2);
+  const int calls = 2000;
+  double dispatch = BestSeconds(3, [&] {
+    uint64_t total = 0;
+    for (int i = 0; i < calls; ++i)
+      total += s21::reduce(s21::execution::parallel_policy{8}, small,
+                           uint64_t(0));
+    sink = total;
+  });
+  std::printf("  %-22s %4u %10.1f us per call\n", "s21::reduce 2^17", 8,
+              dispatch * 1e6 / calls);
+}
+
+// Sizes beyond 1e7 need several GB; raise the limit with S21_RADIX_MAX.
+void BenchRadixSort() {
+  const char* env = std::getenv("S21_RADIX_MAX");
+  size_t limit = env ? (size_t)std::strtod(env, nullptr) : 10000000;
+  std::printf("radix_sort vs s21::sort on uint32, ms\n");
+  for (size_t n = 1000000; n <= limit; n *= 10) {
+    s21::Vector<uint32_t> vec(n);
+    double fill = BestSeconds(3, [&] { FillRandom(vec, 1); });
+    double sorted = BestSeconds(3, [&] {
+                      FillRandom(vec, 1);
+                      s21::sort(vec);
+                    }) -
+                    fill;
+    double radix = BestSeconds(3, [&] {
+                     FillRandom(vec, 1);
+                     s21::radix_sort(vec);
+                   }) -
+                   fill;
+    double narrow = BestSeconds(3, [&] {
+                      FillRandom(vec, 1);
+                      for (size_t i = 0; i < n; ++i) vec[i] &= 0xFFFF;
+                      s21::radix_sort(vec);
+                    }) -
+                    fill;
+    std::printf("  n=%-11zu sort %9.1f  radix %9.1f  radix 16-bit %9.1f  "
+                "%5.2fx\n",
+                n, sorted * 1e3, radix * 1e3, narrow * 1e3, sorted / radix);
+  }
+}
+
+template <size_t Arity>
+void BenchHeapArity(const s21::Vector<uint32_t>& keys, double base) {
+  size_t n = keys.size();
+  double seconds = BestSeconds(3, [&] {
+    s21::PriorityQueue<uint32_t, s21::Vector<uint32_t>,
+                       s21::SingleComparator<uint32_t>, Arity>
+        pq;
+    for (size_t i = 0; i < n; ++i) pq.push(keys[i]);
+    while (!pq.empty()) {
+      sink = pq.top();
+      pq.pop();
+    }
+  });
+  char name[40];
+  std::snprintf(name, sizeof(name), "s21::PriorityQueue arity %zu", Arity);
+  std::printf("  %-36s %9.1f ms %8.2fx\n", name, seconds * 1e3,
+              base / seconds);
+}
+
+void BenchPriorityQueue() {
+  const size_t n = size_t(1) << 20;
+  s21::Vector<uint32_t> keys(n);
+  FillRandom(keys, 7);
+  std::printf("push %zu random uint32 then pop all, ms / speedup\n", n);
+  double base = BestSeconds(3, [&] {
+    std::priority_queue<uint32_t> pq;
+    for (size_t i = 0; i < n; ++i) pq.push(keys[i]);
+    while (!pq.empty()) {
+      sink = pq.top();
+      pq.pop();
+    }
+  });
+  std::printf("  %-36s %9.1f ms\n", "std::priority_queue", base * 1e3);
+  BenchHeapArity<2>(keys, base);
+  BenchHeapArity<4>(keys, base);
+  BenchHeapArity<8>(keys, base);
+  double heapify = BestSeconds(3, [&] {
+    s21::PriorityQueue<uint32_t> pq(keys.cbegin(), keys.cend());
+    sink = pq.top();
+  });
+  std::printf("  %-36s %9.1f ms\n", "s21::PriorityQueue heapify",
+              heapify * 1e3);
+}
+
+uint32_t NextRandom(uint32_t& state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+// Erases and re-creates elements while a second list allocates and frees
+// nodes of the same size, so the survivors end up scattered over the heap.
+void ChurnList(s21::List<uint32_t>& list, uint32_t& state) {
+  s21::List<uint32_t> noise;
+  for (int round = 0; round < 4; ++round) {
+    size_t n = list.size();
+    auto it = list.begin();
+    for (size_t i = 0; i < n; ++i) {
+      auto next = it + 1;
+      if (NextRandom(state) & 1) {
+        uint32_t value = *it;
+        list.erase(it);
+        noise.push_back(value);
+        list.push_back(value);
+      }
+      if (noise.size() > 64 && (NextRandom(state) & 1)) noise.pop_front();
+      it = next;
+    }
+  }
+}
+
+void ChurnSet(s21::Set<uint32_t>& set, uint32_t& state) {
+  s21::List<uint32_t> noise;
+  s21::Vector<uint32_t> keys;
+  for (auto it = set.begin(); it != set.end(); ++it) keys.push_back(*it);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    size_t victim = NextRandom(state) % keys.size();
+    set.erase(set.find(keys[victim]));
+    noise.push_back(keys[victim]);
+    if (noise.size() > 64) noise.pop_front();
+    uint32_t fresh = NextRandom(state);
+    while (!set.insert(fresh).second) fresh = NextRandom(state);
+    keys[victim] = fresh;
+  }
+}
+
+void BenchCompact() {
+  const size_t n = size_t(1) << 20;
+  uint32_t state = 99;
+  s21::List<uint32_t> list;
+  for (size_t i = 0; i < n; ++i) list.push_back((uint32_t)i);
+  auto iterate_list = [&] {
+    uint64_t sum = 0;
+    for (auto it = list.begin(); it != list.end(); ++it) sum += *it;
+    sink = sum;
+  };
+  std::printf("iteration over %zu nodes, ns per element\n", n);
+  double fresh = BestSeconds(5, iterate_list);
+  ChurnList(list, state);
+  double churned = BestSeconds(5, iterate_list);
+  list.compact();
+  double compacted = BestSeconds(5, iterate_list);
+  std::printf("  %-14s fresh %6.2f  churned %6.2f  compacted %6.2f\n",
+              "s21::List", fresh * 1e9 / n, churned * 1e9 / n,
+              compacted * 1e9 / n);
+
+  s21::Set<uint32_t> set;
+  s21::Vector<uint32_t> probes(n);
+  FillRandom(probes, 5);
+  for (size_t i = 0; i < n; ++i) set.insert(probes[i]);
+  auto iterate_set = [&] {
+    uint64_t sum = 0;
+    for (auto it = set.begin(); it != set.end(); ++it) sum += *it;
+    sink = sum;
+  };
+  auto find_set = [&] {
+    size_t found = 0;
+    for (size_t i = 0; i < n; ++i) found += set.contains(probes[i]);
+    sink = found;
+  };
+  fresh = BestSeconds(3, iterate_set);
+  double fresh_find = BestSeconds(3, find_set);
+  ChurnSet(set, state);
+  churned = BestSeconds(3, iterate_set);
+  double churned_find = BestSeconds(3, find_set);
+  set.compact();
+  compacted = BestSeconds(3, iterate_set);
+  double compacted_find = BestSeconds(3, find_set);
+  std::printf("  %-14s fresh %6.2f  churned %6.2f  compacted %6.2f\n",
+              "s21::Set", fresh * 1e9 / n, churned * 1e9 / n,
+              compacted * 1e9 / n);
+  std::printf("  %-14s fresh %6.2f  churned %6.2f  compacted %6.2f\n",
+              "Set::contains", fresh_find * 1e9 / n, churned_find * 1e9 / n,
+              compacted_find * 1e9 / n);
+}
+
+template <class SetType>
+void BenchNodeLayout(const char* name, const s21::Vector<uint32_t>& keys,
+                     const s21::Vector<uint32_t>& probes) {
+  size_t n = keys.size();
+  long long before = live_bytes;
+  SetType* set = new SetType;
+  double inserted = BestSeconds(1, [&] {
+    for (size_t i = 0; i < n; ++i) set->insert(keys[i]);
+  });
+  long long bytes = live_bytes - before;
+  double found = BestSeconds(3, [&] {
+    size_t hits = 0;
+    for (size_t i = 0; i < n; ++i) hits += set->contains(probes[i]);
+    sink = hits;
+  });
+  std::printf("  %-16s %7.1f MB %6.1f B/key  insert %6.1f ns  "
+              "contains %6.1f ns\n",
+              name, bytes / 1e6, (double)bytes / n, inserted * 1e9 / n,
+              found * 1e9 / n);
+  delete set;
+}
+
+void BenchNodeLayouts() {
+  const size_t n = size_t(1) << 21;
+  s21::Vector<uint32_t> keys(n);
+  s21::Vector<uint32_t> probes(n);
+  FillRandom(keys, 3);
+  for (size_t i = 0; i < n; ++i) probes[i] = keys[(i * 7919) % n] + (i & 1);
+  std::printf("Set<uint32_t> with %zu random keys\n", n);
+  BenchNodeLayout<s21::Set<uint32_t>>("PointerNodes", keys, probes);
+  BenchNodeLayout<s21::Set<uint32_t, s21::SingleComparator<uint32_t>,
+                           s21::CompactNodes>>("CompactNodes", keys, probes);
+}
+
+void BenchFrozen() {
+  const size_t n = size_t(1) << 22;
+  s21::Vector<uint32_t> keys(n);
+  s21::Vector<uint32_t> probes(n);
+  FillRandom(keys, 11);
+  for (size_t i = 0; i < n; ++i) probes[i] = keys[(i * 7919) % n] + (i & 1);
+  s21::Set<uint32_t> set;
+  for (size_t i = 0; i < n; ++i) set.insert(keys[i]);
+  s21::FrozenSet<uint32_t> frozen = set.freeze();
+  std::vector<uint32_t> sorted;
+  for (auto it = frozen.begin(); it != frozen.end(); ++it)
+    sorted.push_back(*it);
+  std::printf("lookups in %zu random uint32 keys, ns per lookup\n", n);
+  auto report = [&](const char* name, double seconds, double base) {
+    std::printf("  %-36s %8.1f ns %8.2fx\n", name, seconds * 1e9 / n,
+                base / seconds);
+  };
+  double tree = BestSeconds(3, [&] {
+    size_t hits = 0;
+    for (size_t i = 0; i < n; ++i) hits += set.contains(probes[i]);
+    sink = hits;
+  });
+  report("Set::contains", tree, tree);
+  report("std::binary_search", BestSeconds(3, [&] {
+           size_t hits = 0;
+           for (size_t i = 0; i < n; ++i)
+             hits += std::binary_search(sorted.begin(), sorted.end(),
+                                        probes[i]);
+           sink = hits;
+         }),
+         tree);
+  report("FrozenSet::contains", BestSeconds(3, [&] {
+           size_t hits = 0;
+           for (size_t i = 0; i < n; ++i) hits += frozen.contains(probes[i]);
+           sink = hits;
+         }),
+         tree);
+}
+
+// Startup cost of a Map<uint32_t, uint32_t>: building it from random inserts,
+// loading a snapshot, and mapping the snapshot. S21_SNAPSHOT_N sets the size.
+void BenchSnapshot() {
+  const char* env = std::getenv("S21_SNAPSHOT_N");
+  const size_t n = env ? (size_t)std::strtod(env, nullptr) : 4000000;
+  const size_t lookups = 1000000;
+  const std::string path = "/tmp/s21_benchmark.snap";
+  s21::Vector<uint32_t> keys(n);
+  FillRandom(keys, 17);
+  std::printf("Map<uint32_t, uint32_t> with %zu random keys, ms\n", n);
+  s21::Map<uint32_t, uint32_t> map;
+  double built = BestSeconds(1, [&] {
+    for (size_t i = 0; i < n; ++i) map.insert(keys[i], (uint32_t)i);
+  });
+  double saved = BestSeconds(1, [&] { map.save(path); });
+  s21::Map<uint32_t, uint32_t> loaded;
+  double load = BestSeconds(1, [&] { loaded.load(path); });
+  double opened = 0;
+  double probed = BestSeconds(1, [&] {
+    auto start = Clock::now();
+    s21::MappedMap<uint32_t, uint32_t> mapped(path);
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    opened = elapsed.count();
+    size_t hits = 0;
+    for (size_t i = 0; i < lookups; ++i)
+      hits += mapped.contains(keys[(i * 7919) % n]);
+    sink = hits;
+  });
+  std::printf("  %-36s %10.1f\n", "build by insert", built * 1e3);
+  std::printf("  %-36s %10.1f\n", "save", saved * 1e3);
+  std::printf("  %-36s %10.1f\n", "load + rebalance", load * 1e3);
+  std::printf("  %-36s %10.3f\n", "MappedMap open", opened * 1e3);
+  std::printf("  %-36s %10.1f\n", "MappedMap open + 1M lookups",
+              probed * 1e3);
+  std::remove(path.c_str());
+}
+
+// Point-in-time views of a map that keeps changing: a Map must be copied,
+// a PersistentMap snapshot shares its nodes.
+void BenchPersistent() {
+  const size_t n = size_t(1) << 20;
+  const size_t updates = 100000;
+  s21::Vector<uint32_t> keys(n);
+  FillRandom(keys, 23);
+  s21::Map<uint32_t, uint32_t> map;
+  s21::PersistentMap<uint32_t, uint32_t> persistent;
+  for (size_t i = 0; i < n; ++i) {
+    map.insert(keys[i], (uint32_t)i);
+    persistent.insert(keys[i], (uint32_t)i);
+  }
+  std::printf("%zu random uint32 keys\n", n);
+  double copied = BestSeconds(1, [&] {
+    s21::Map<uint32_t, uint32_t> copy(map);
+    sink = copy.size();
+  });
+  double snapshot = BestSeconds(3, [&] {
+    auto view = persistent.snapshot();
+    sink = view.size();
+  });
+  std::printf("  %-36s %10.3f ms\n", "Map copy", copied * 1e3);
+  std::printf("  %-36s %10.3f ms\n", "PersistentMap::snapshot",
+              snapshot * 1e3);
+  auto view = persistent.snapshot();
+  double assign = BestSeconds(1, [&] {
+    for (size_t i = 0; i < updates; ++i)
+      persistent.insert_or_assign(keys[(i * 7919) % n], (uint32_t)i);
+  });
+  double lookup = BestSeconds(3, [&] {
+    size_t hits = 0;
+    for (size_t i = 0; i < updates; ++i)
+      hits += persistent.contains(keys[(i * 7919) % n]);
+    sink = hits;
+  });
+  std::printf("  %-36s %10.1f ns\n", "insert_or_assign, snapshot held",
+              assign * 1e9 / updates);
+  std::printf("  %-36s %10.1f ns\n", "contains", lookup * 1e9 / updates);
+  sink = view.size();
+}
+
+// Two producers feeding two consumers. The baseline is what pipelines did
+// before BlockingQueue: a mutex around s21::Queue, polled until non-empty.
+template <class Consume>
+double RunPipeline(Consume consume, void (*produce)(size_t, size_t),
+                   size_t items) {
+  auto start = Clock::now();
+  std::vector<std::thread> threads;
+  for (size_t p = 0; p < 2; ++p) threads.emplace_back(produce, p, items / 2);
+  for (size_t c = 0; c < 2; ++c) threads.emplace_back(consume);
+  for (auto& thread : threads) thread.join();
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+  return elapsed.count();
+}
+
+std::mutex naive_mutex;
+s21::Queue<uint32_t>* naive_queue;
+std::atomic<size_t> naive_left;
+s21::BlockingQueue<uint32_t>* blocking_queue;
+std::atomic<size_t> producers_left;
+
+void BenchBlockingQueue() {
+  const size_t items = 2000000;
+  std::printf("%zu items, 2 producers, 2 consumers, items/s\n", items);
+  s21::Queue<uint32_t> queue;
+  naive_queue = &queue;
+  naive_left = items;
+  double naive = RunPipeline(
+      [] {
+        while (naive_left.load() > 0) {
+          std::unique_lock<std::mutex> lock(naive_mutex);
+          if (naive_queue->empty()) {
+            lock.unlock();
+            std::this_thread::yield();
+            continue;
+          }
+          sink = naive_queue->front();
+          naive_queue->pop();
+          --naive_left;
+        }
+      },
+      [](size_t p, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+          std::lock_guard<std::mutex> lock(naive_mutex);
+          naive_queue->push((uint32_t)(p + i));
+        }
+      },
+      items);
+  std::printf("  %-36s %12.0f\n", "mutex + s21::Queue, polling",
+              items / naive);
+  for (size_t batch : {(size_t)1, (size_t)64}) {
+    s21::BlockingQueue<uint32_t> blocking(1024);
+    blocking_queue = &blocking;
+    producers_left = 2;
+    auto consume = [batch] {
+      s21::Vector<uint32_t> out;
+      uint32_t value;
+      if (batch == 1) {
+        while (blocking_queue->pop(value)) sink = value;
+      } else {
+        while (blocking_queue->pop_batch(batch, out)) out.clear();
+      }
+    };
+    double seconds = RunPipeline(
+        consume,
+        [](size_t p, size_t n) {
+          for (size_t i = 0; i < n; ++i)
+            blocking_queue->push((uint32_t)(p + i));
+          if (!--producers_left) blocking_queue->close();
+        },
+        items);
+    std::printf("  BlockingQueue, %-21s %12.0f\n",
+                batch == 1 ? "pop" : "pop_batch(64)", items / seconds);
+  }
+}
+
+// Free-list traffic: every thread pushes and pops in turn. On a single core
+// threads are time-sliced, so this measures overhead more than scaling.
+template <class PushPop>
+double RunPushPop(size_t threads, size_t ops, PushPop push_pop) {
+  auto start = Clock::now();
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t)
+    workers.emplace_back([&, t] {
+      for (size_t i = 0; i < ops; ++i) push_pop((uint32_t)(t + i));
+    });
+  for (auto& worker : workers) worker.join();
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+  return elapsed.count();
+}
+
+void BenchLockFreeStack() {
+  const size_t ops = 500000;
+  std::printf("push + pop pairs per second (millions)\n");
+  std::printf("  %-8s %16s %16s\n", "threads", "mutex + Stack",
+              "LockFreeStack");
+  for (size_t threads = 1; threads <= 8; threads *= 2) {
+    std::mutex mutex;
+    s21::Stack<uint32_t> locked;
+    double naive = RunPushPop(threads, ops, [&](uint32_t value) {
+      std::lock_guard<std::mutex> lock(mutex);
+      locked.push(value);
+      sink = locked.top();
+      locked.pop();
+    });
+    s21::LockFreeStack<uint32_t> lock_free;
+    double fast = RunPushPop(threads, ops, [&](uint32_t value) {
+      lock_free.push(value);
+      lock_free.try_pop(value);
+      sink = value;
+    });
+    std::printf("  %-8zu %16.1f %16.1f\n", threads,
+                threads * ops / naive / 1e6, threads * ops / fast / 1e6);
+  }
+}
+
+void BenchThreadPool() {
+  const size_t tasks = 1000000;
+  std::printf("task spawn overhead, ns per task\n");
+  {
+    s21::ThreadPool pool(2);
+    std::atomic<size_t> done{0};
+    double external = BestSeconds(3, [&] {
+      for (size_t i = 0; i < tasks; ++i)
+        pool.submit([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+      pool.wait();
+    });
+    double internal = BestSeconds(3, [&] {
+      pool.submit([&] {
+        for (size_t i = 0; i < tasks; ++i)
+          pool.submit(
+              [&done] { done.fetch_add(1, std::memory_order_relaxed); });
+      });
+      pool.wait();
+    });
+    std::printf("  %-36s %10.1f\n", "submit from outside the pool",
+                external * 1e9 / tasks);
+    std::printf("  %-36s %10.1f\n", "submit from a worker",
+                internal * 1e9 / tasks);
+  }
+  const size_t threads_spawned = 10000;
+  double spawned = BestSeconds(1, [&] {
+    for (size_t i = 0; i < threads_spawned; ++i)
+      std::thread([] { sink = 1; }).join();
+  });
+  std::printf("  %-36s %10.1f\n", "std::thread per task",
+              spawned * 1e9 / threads_spawned);
+
+  const size_t n = size_t(1) << 25;
+  s21::Vector<uint32_t> values(n);
+  FillRandom(values, 29);
+  std::printf("sum of %zu uint32 with parallel_for, ms\n", n);
+  for (unsigned threads = 1; threads <= 4; threads *= 2) {
+    s21::ThreadPool pool(threads);
+    for (size_t grain : {size_t(1) << 12, size_t(1) << 16}) {
+      std::atomic<uint64_t> total{0};
+      double seconds = BestSeconds(3, [&] {
+        total = 0;
+        pool.parallel_for(0, n, grain, [&](size_t lo, size_t hi) {
+          uint64_t part = 0;
+          for (size_t i = lo; i < hi; ++i) part += values[i];
+          total.fetch_add(part, std::memory_order_relaxed);
+        });
+      });
+      sink = total.load();
+      std::printf("  %u threads, grain %-8zu %24.2f\n", threads, grain,
+                  seconds * 1e3);
+    }
+  }
+}
+
+// Node-per-element List against UnrolledList: a full traversal, inserts at a
+// fixed middle iterator, and inserts that first walk to a random position.
+template <class L>
+void BenchListLayout(const char* name, size_t n, size_t walks) {
+  L list;
+  for (size_t i = 0; i < n; ++i) list.push_back((uint32_t)i);
+  double traverse = BestSeconds(5, [&] {
+    uint64_t total = 0;
+    for (auto it = list.begin(); it != list.end(); ++it) total += *it;
+    sink = total;
+  });
+  double middle = BestSeconds(3, [&] {
+    L grown;
+    for (size_t i = 0; i < n / 2; ++i) grown.push_back((uint32_t)i);
+    auto pos = grown.begin() + (int)(n / 4);
+    for (size_t i = 0; i < n / 2; ++i) pos = grown.insert(pos, (uint32_t)i);
+    sink = grown.size();
+  });
+  double walked = BestSeconds(3, [&] {
+    L grown;
+    for (size_t i = 0; i < n / 8; ++i) grown.push_back((uint32_t)i);
+    uint32_t state = 1;
+    for (size_t i = 0; i < walks; ++i) {
+      state = state * 1664525u + 1013904223u;
+      auto pos = grown.begin() + (int)(state % grown.size());
+      grown.insert(pos, (uint32_t)i);
+    }
+    sink = grown.size();
+  });
+  std::printf("  %-16s %12.2f %16.1f %16.0f\n", name, traverse * 1e9 / n,
+              middle * 1e9 / (n / 2), walked * 1e9 / walks);
+}
+
+void BenchUnrolledList() {
+  const size_t n = size_t(1) << 21;
+  const size_t walks = 2000;
+  std::printf("%zu uint32 elements, ns per element or insert\n", n);
+  std::printf("  %-16s %12s %16s %16s\n", "", "traverse", "insert at it",
+              "walk + insert");
+  BenchListLayout<s21::List<uint32_t>>("List", n, walks);
+  BenchListLayout<s21::UnrolledList<uint32_t>>("UnrolledList", n, walks);
+}
+
+// Zipf-distributed keys: key k in [0, n) is drawn with weight 1 / (k + 1)^s,
+// then scrambled so hot keys are not adjacent.
+s21::Vector<uint32_t> ZipfTrace(size_t n, double s, size_t length,
+                                uint32_t seed) {
+  std::vector<double> cdf(n);
+  double total = 0;
+  for (size_t k = 0; k < n; ++k) cdf[k] = total += 1.0 / std::pow(k + 1.0, s);
+  s21::Vector<uint32_t> trace(length);
+  uint64_t state = seed;
+  for (size_t i = 0; i < length; ++i) {
+    state = state * 6364136223846793005u + 1442695040888963407u;
+    double u = (double)(state >> 11) / (double)(uint64_t(1) << 53) * total;
+    size_t k = std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin();
+    trace[i] = (uint32_t)(std::min(k, n - 1) * 2654435761u);
+  }
+  return trace;
+}
+
+// The cache-aside pattern the caches are built for: get, and put on a miss.
+template <class Cache>
+void ReplayTrace(const char* name, const s21::Vector<uint32_t>& trace,
+                 size_t capacity) {
+  double best = 0;
+  double hit_rate = 0;
+  size_t allocated = 0;
+  for (int round = 0; round < 3; ++round) {
+    Cache cache(capacity);
+    size_t before = allocations;
+    auto start = Clock::now();
+    for (size_t i = 0; i < trace.size(); ++i)
+      if (!cache.get(trace[i])) cache.put(trace[i], trace[i]);
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    allocated = allocations - before;
+    hit_rate = (double)cache.hits() / trace.size();
+    if (!round || elapsed.count() < best) best = elapsed.count();
+  }
+  std::printf("  %-28s %10.2f %10.1f%% %10zu\n", name,
+              trace.size() / best / 1e6, hit_rate * 100, allocated);
+}
+
+// The usual hand-written LRU: a list for recency and a hash map into it.
+class StdLruCache {
+ public:
+  explicit StdLruCache(size_t capacity) : capacity_(capacity) {}
+
+  uint32_t* get(uint32_t key) {
+    auto found = index_.find(key);
+    if (found == index_.end()) return nullptr;
+    ++hits_;
+    order_.splice(order_.begin(), order_, found->second);
+    return &found->second->second;
+  }
+
+  void put(uint32_t key, uint32_t value) {
+    if (order_.size() == capacity_) {
+      index_.erase(order_.back().first);
+      order_.pop_back();
+    }
+    order_.emplace_front(key, value);
+    index_[key] = order_.begin();
+  }
+
+  size_t hits() const { return hits_; }
+
+ private:
+  using Order = std::list<std::pair<uint32_t, uint32_t>>;
+
+  size_t capacity_;
+  size_t hits_ = 0;
+  Order order_;
+  std::unordered_map<uint32_t, Order::iterator> index_;
+};
+
+void BenchCache() {
+  const size_t keys = 1000000;
+  const size_t length = 4000000;
+  s21::Vector<uint32_t> trace = ZipfTrace(keys, 0.99, length, 37);
+  for (size_t capacity : {size_t(10000), size_t(100000)}) {
+    std::printf("Zipf(0.99) over %zu keys, capacity %zu\n", keys, capacity);
+    std::printf("  %-28s %10s %11s %10s\n", "", "Mops/s", "hit rate",
+                "allocs");
+    ReplayTrace<StdLruCache>("std::list + unordered_map", trace, capacity);
+    ReplayTrace<s21::LruCache<uint32_t, uint32_t>>("LruCache", trace,
+                                                    capacity);
+    ReplayTrace<s21::ClockCache<uint32_t, uint32_t>>("ClockCache", trace,
+                                                      capacity);
+  }
+}
+
+// Batched lookups in a map much larger than the last-level cache. A batch
+// of one is the plain serial descent.
+void BenchFindMany() {
+  const size_t n = size_t(1) << 22;
+  const size_t lookups = size_t(1) << 20;
+  s21::Vector<uint32_t> keys(n);
+  FillRandom(keys, 41);
+  s21::Map<uint32_t, uint32_t> map;
+  for (size_t i = 0; i < n; ++i) map.insert(keys[i], (uint32_t)i);
+  s21::Vector<uint32_t> probes(lookups);
+  for (size_t i = 0; i < lookups; ++i)
+    probes[i] = keys[(i * 7919) % n] + (i & 1);
+  std::printf("Map<uint32_t, uint32_t> with %zu random keys, "
+              "Mlookups/s\n", n);
+  double serial = 0;
+  for (size_t batch : {1, 16, 64, 256, 512}) {
+    s21::Vector<uint32_t> group(batch);
+    s21::Vector<s21::Map<uint32_t, uint32_t>::iterator> found;
+    double seconds = BestSeconds(3, [&] {
+      size_t hits = 0;
+      for (size_t first = 0; first + batch <= lookups; first += batch) {
+        for (size_t i = 0; i < batch; ++i) group[i] = probes[first + i];
+        map.find_many(group, found);
+        for (size_t i = 0; i < batch; ++i) hits += found[i] != map.end();
+      }
+      sink = hits;
+    });
+    if (batch == 1) serial = seconds;
+    std::printf("  find_many, batch %-18zu %10.2f %8.2fx\n", batch,
+                lookups / seconds / 1e6, serial / seconds);
+  }
+}
+
+// Set::contains with and without the Bloom filter as the share of present
+// keys varies.
+void BenchBloom() {
+  const size_t n = size_t(1) << 22;
+  const size_t lookups = size_t(1) << 20;
+  s21::Vector<uint32_t> keys(n);
+  FillRandom(keys, 43);
+  s21::Set<uint32_t> set;
+  for (size_t i = 0; i < n; ++i) set.insert(keys[i] | 1);
+  std::printf("Set<uint32_t> with %zu random keys, ns per contains\n", n);
+  std::printf("  %-12s %12s %12s %10s\n", "hit rate", "no filter", "filter",
+              "speedup");
+  for (unsigned percent : {1u, 10u, 90u}) {
+    s21::Vector<uint32_t> probes(lookups);
+    for (size_t i = 0; i < lookups; ++i) {
+      uint32_t key = keys[(i * 7919) % n];
+      probes[i] = (i * 37 % 100) < percent ? key | 1 : key & ~1u;
+    }
+    double seconds[2];
+    for (int bloom = 0; bloom < 2; ++bloom) {
+      set.enable_bloom(bloom);
+      seconds[bloom] = BestSeconds(3, [&] {
+        size_t hits = 0;
+        for (size_t i = 0; i < lookups; ++i) hits += set.contains(probes[i]);
+        sink = hits;
+      });
+    }
+    std::printf("  %-12u %12.1f %12.1f %9.2fx\n", percent,
+                seconds[0] * 1e9 / lookups, seconds[1] * 1e9 / lookups,
+                seconds[0] / seconds[1]);
+  }
+  set.enable_bloom(false);
+  const size_t misses = size_t(1) << 24;
+  s21::BloomFilter filter(n);
+  for (size_t i = 0; i < n; ++i) filter.Insert(s21::BloomHash(keys[i] | 1));
+  double probe = BestSeconds(3, [&] {
+    size_t passed = 0;
+    for (size_t i = 0; i < misses; ++i)
+      passed += filter.MayContain(s21::BloomHash(i * 2));
+    sink = passed;
+  });
+  std::printf("  BloomFilter::MayContain alone %8.1f ns\n",
+              probe * 1e9 / misses);
+}
+
+void BenchHeterogeneous() {
+  const size_t n = size_t(1) << 16;
+  const size_t lookups = size_t(1) << 20;
+  s21::Vector<uint32_t> ids(n);
+  FillRandom(ids, 47);
+  // Longer than the small string buffer, so every std::string allocates.
+  s21::Vector<std::string> keys(n);
+  s21::Map<std::string, int> map;
+  for (size_t i = 0; i < n; ++i) {
+    keys[i] = "/var/lib/containers/objects/" + std::to_string(ids[i]);
+    map.insert(keys[i], (int)i);
+  }
+  s21::Vector<const char*> probes(lookups);
+  for (size_t i = 0; i < lookups; ++i)
+    probes[i] = keys[(i * 7919) % n].c_str();
+  std::printf("Map<std::string, int> with %zu keys, per at()\n", n);
+  std::printf("  %-24s %10s %12s\n", "probe", "ns", "allocations");
+  auto run = [&](const char* name, auto lookup) {
+    size_t before = allocations;
+    double seconds = BestSeconds(3, [&] {
+      long total = 0;
+      for (size_t i = 0; i < lookups; ++i) total += lookup(probes[i]);
+      sink = total;
+    });
+    std::printf("  %-24s %10.1f %12.2f\n", name, seconds * 1e9 / lookups,
+                (double)(allocations - before) / (3.0 * lookups));
+  };
+  run("std::string(probe)",
+      [&](const char* probe) { return map.at(std::string(probe)); });
+  run("std::string_view(probe)",
+      [&](const char* probe) { return map.at(std::string_view(probe)); });
+  run("const char*", [&](const char* probe) { return map.at(probe); });
+}
+
+#ifdef __cpp_impl_coroutine
+s21::coro::Task Ping(s21::Channel<uint32_t>* out, s21::Channel<uint32_t>* in,
+                     size_t rounds) {
+  for (size_t i = 0; i < rounds; ++i) {
+    co_await out->send((uint32_t)i);
+    sink = *co_await in->receive();
+  }
+  out->close();
+}
+
+s21::coro::Task Pong(s21::Channel<uint32_t>* in, s21::Channel<uint32_t>* out) {
+  while (std::optional<uint32_t> value = co_await in->receive())
+    co_await out->send(*value);
+}
+
+s21::coro::Task Produce(s21::Channel<uint32_t>* out, size_t n) {
+  for (size_t i = 0; i < n; ++i) co_await out->send((uint32_t)i);
+}
+
+s21::coro::Task Drain(s21::Channel<uint32_t>* in, size_t n) {
+  for (size_t i = 0; i < n; ++i) sink = *co_await in->receive();
+}
+
+// Coroutines on one thread against threads blocking on a condition
+// variable queue.
+void BenchChannel() {
+  const size_t rounds = 500000;
+  std::printf("ping-pong, ns per round trip\n");
+  double coroutines = BestSeconds(3, [&] {
+    s21::coro::SingleThreadExecutor executor;
+    s21::Channel<uint32_t> a(1), b(1);
+    executor.Spawn(Ping(&a, &b, rounds));
+    executor.Spawn(Pong(&a, &b));
+    executor.Run();
+  });
+  double threads = BestSeconds(3, [&] {
+    s21::BlockingQueue<uint32_t> a(1), b(1);
+    std::thread pong([&] {
+      uint32_t value;
+      while (a.pop(value)) b.push(value);
+    });
+    uint32_t value;
+    for (size_t i = 0; i < rounds; ++i) {
+      a.push((uint32_t)i);
+      b.pop(value);
+    }
+    a.close();
+    pong.join();
+  });
+  std::printf("  %-36s %10.1f\n", "Channel, single-thread executor",
+              coroutines * 1e9 / rounds);
+  std::printf("  %-36s %10.1f\n", "BlockingQueue, two threads",
+              threads * 1e9 / rounds);
+
+  const size_t producers = 8;
+  const size_t per_producer = 250000;
+  const size_t items = producers * per_producer;
+  std::printf("fan-in of %zu producers, items/s\n", producers);
+  coroutines = BestSeconds(3, [&] {
+    s21::coro::SingleThreadExecutor executor;
+    s21::Channel<uint32_t> channel(256);
+    executor.Spawn(Drain(&channel, items));
+    for (size_t p = 0; p < producers; ++p)
+      executor.Spawn(Produce(&channel, per_producer));
+    executor.Run();
+  });
+  threads = BestSeconds(3, [&] {
+    s21::BlockingQueue<uint32_t> queue(256);
+    std::vector<std::thread> workers;
+    for (size_t p = 0; p < producers; ++p)
+      workers.emplace_back([&] {
+        for (size_t i = 0; i < per_producer; ++i) queue.push((uint32_t)i);
+      });
+    uint32_t value;
+    for (size_t i = 0; i < items; ++i) queue.pop(value);
+    for (auto& worker : workers) worker.join();
+  });
+  std::printf("  %-36s %12.0f\n", "Channel, single-thread executor",
+              items / coroutines);
+  std::printf("  %-36s %12.0f\n", "BlockingQueue, one thread each",
+              items / threads);
+}
+#endif  // __cpp_impl_coroutine
+
+struct Benchmark {
+  const char* name;
+  void (*run)();
+};
+
+const Benchmark kBenchmarks[] = {
+    {"simd", BenchSimd},
+    {"smallvector", BenchSmallVector},
+    {"parallel", BenchParallelSort},
+    {"radix", BenchRadixSort},
+    {"heap", BenchPriorityQueue},
+    {"compact", BenchCompact},
+    {"nodes", BenchNodeLayouts},
+    {"frozen", BenchFrozen},
+    {"snapshot", BenchSnapshot},
+    {"persistent", BenchPersistent},
+    {"blocking", BenchBlockingQueue},
+#ifdef __cpp_impl_coroutine
+    {"channel", BenchChannel},
+#endif
+    {"lockfree", BenchLockFreeStack},
+    {"pool", BenchThreadPool},
+    {"unrolled", BenchUnrolledList},
+    {"cache", BenchCache},
+    {"findmany", BenchFindMany},
+    {"bloom", BenchBloom},
+    {"heterogeneous", BenchHeterogeneous},
+};
+}  // namespace
+
+int main(int argc, char** argv) {
+  for (const Benchmark& bench : kBenchmarks) {
+    bool selected = argc < 2;
+    for (int i = 1; i < argc; ++i)
+      if (!std::strcmp(argv[i], bench.name)) selected = true;
+    if (selected) bench.run();
+  }
+  return 0;
+}
@@ -0,0 +1,328 @@
+#ifndef CONTAINERS_SRC_S21_ALGORITHM_H_
+#define CONTAINERS_SRC_S21_ALGORITHM_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+#include "s21_thread_pool.h"
+#include "s21_vector.h"
+
+namespace s21 {
+namespace execution {
+struct sequenced_policy {};
+
+// The work is split into `threads` pieces, which run on the shared pool of
+// parallel::Pool(); 0 means std::thread::hardware_concurrency().
+struct parallel_policy {
+  unsigned threads = 0;
+};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+}  // namespace execution
+
+namespace parallel {
+// Below this many elements per worker the sequential code is faster.
+constexpr size_t kGrain = size_t(1) << 14;
+
+inline unsigned Workers(const execution::sequenced_policy &, size_t) {
+  return 1;
+}
+
+inline unsigned Workers(const execution::parallel_policy &policy, size_t n) {
+  unsigned threads = policy.threads;
+  if (!threads) threads = std::max(1u, std::thread::hardware_concurrency());
+  size_t useful = n / kGrain;
+  return useful < threads ? (unsigned)std::max<size_t>(useful, 1) : threads;
+}
+
+// Shared by the parallel algorithms and started on first use, with one
+// worker per hardware thread. Never destroyed, so algorithms may still run
+// during static destruction.
+inline ThreadPool &Pool() {
+  static ThreadPool *pool = new ThreadPool;
+  return *pool;
+}
+
+// Runs fn(0) ... fn(tasks - 1) on the shared pool, the caller included, and
+// returns when all of them have finished. Calls from inside a task run on
+// the same workers instead of starting more threads.
+template <class F>
+void Run(size_t tasks, unsigned threads, F &&fn) {
+  if (threads <= 1 || tasks <= 1) {
+    for (size_t i = 0; i < tasks; ++i) fn(i);
+    return;
+  }
+  Pool().parallel_for(0, tasks, 1, [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) fn(i);
+  });
+}
+
+inline size_t ChunkBegin(size_t n, size_t chunks, size_t i) {
+  return n / chunks * i + std::min(i, n % chunks);
+}
+
+// Number of elements of `a` among the first `d` outputs of a stable merge.
+template <class T, class Compare>
+size_t CoRank(size_t d, const T *a, size_t na, const T *b, size_t nb,
+              Compare comp) {
+  size_t lo = d > nb ? d - nb : 0;
+  size_t hi = std::min(d, na);
+  while (lo < hi) {
+    size_t i = lo + (hi - lo) / 2;
+    size_t j = d - i;
+    if (j > 0 && i < na && !comp(b[j - 1], a[i]))
+      lo = i + 1;
+    else
+      hi = i;
+  }
+  return lo;
+}
+
+// Merges sorted runs [bounds[k], bounds[k + 1]) pairwise until one is left.
+// Returns true when the result ended up in `dst`.
+template <class T, class Compare>
+bool MergeRuns(T *src, T *dst, size_t *bounds, size_t runs, unsigned threads,
+               Compare comp) {
+  bool swapped = false;
+  while (runs > 1) {
+    size_t pairs = (runs + 1) / 2;
+    size_t parts = std::max<size_t>(1, threads / pairs);
+    Run(pairs * parts, threads, [&](size_t task) {
+      size_t pair = task / parts;
+      size_t part = task % parts;
+      size_t first = bounds[2 * pair];
+      size_t middle = bounds[std::min(2 * pair + 1, runs)];
+      size_t last = bounds[std::min(2 * pair + 2, runs)];
+      T *a = src + first;
+      T *b = src + middle;
+      size_t na = middle - first;
+      size_t nb = last - middle;
+      size_t lo = ChunkBegin(na + nb, parts, part);
+      size_t hi = ChunkBegin(na + nb, parts, part + 1);
+      size_t i_lo = CoRank(lo, a, na, b, nb, comp);
+      size_t i_hi = CoRank(hi, a, na, b, nb, comp);
+      std::merge(std::make_move_iterator(a + i_lo),
+                 std::make_move_iterator(a + i_hi),
+                 std::make_move_iterator(b + (lo - i_lo)),
+                 std::make_move_iterator(b + (hi - i_hi)), dst + first + lo,
+                 comp);
+    });
+    for (size_t k = 1; k <= pairs; ++k)
+      bounds[k] = bounds[std::min(2 * k, runs)];
+    std::swap(src, dst);
+    swapped = !swapped;
+    runs = pairs;
+  }
+  return swapped;
+}
+
+template <class Policy, class T, class Compare, class Sorter>
+void SortImpl(const Policy &policy, Vector<T> &v, Compare comp,
+              Sorter sorter) {
+  size_t n = v.size();
+  unsigned threads = Workers(policy, n);
+  T *data = v.data();
+  if (threads <= 1) {
+    sorter(data, data + n, comp);
+    return;
+  }
+  std::unique_ptr<size_t[]> bounds(new size_t[threads + 1]);
+  for (unsigned i = 0; i <= threads; ++i)
+    bounds[i] = ChunkBegin(n, threads, i);
+  Run(threads, threads,
+      [&](size_t i) { sorter(data + bounds[i], data + bounds[i + 1], comp); });
+  Vector<T> scratch;
+  scratch.reserve(n);
+  T *buffer = scratch.data();
+  if (MergeRuns(data, buffer, bounds.get(), threads, threads, comp)) {
+    Run(threads, threads, [&](size_t i) {
+      std::move(buffer + ChunkBegin(n, threads, i),
+                buffer + ChunkBegin(n, threads, i + 1),
+                data + ChunkBegin(n, threads, i));
+    });
+  }
+}
+}  // namespace parallel
+
+template <class Policy, class T, class Compare = std::less<T>>
+void sort(const Policy &policy, Vector<T> &v, Compare comp = Compare()) {
+  parallel::SortImpl(policy, v, comp, [](T *first, T *last, Compare c) {
+    std::sort(first, last, c);
+  });
+}
+
+template <class T, class Compare = std::less<T>>
+void sort(Vector<T> &v, Compare comp = Compare()) {
+  sort(execution::seq, v, comp);
+}
+
+template <class Policy, class T, class Compare = std::less<T>>
+void stable_sort(const Policy &policy, Vector<T> &v,
+                 Compare comp = Compare()) {
+  parallel::SortImpl(policy, v, comp, [](T *first, T *last, Compare c) {
+    std::stable_sort(first, last, c);
+  });
+}
+
+template <class T, class Compare = std::less<T>>
+void stable_sort(Vector<T> &v, Compare comp = Compare()) {
+  stable_sort(execution::seq, v, comp);
+}
+
+template <class Policy, class T, class F>
+void for_each(const Policy &policy, Vector<T> &v, F fn) {
+  size_t n = v.size();
+  unsigned threads = parallel::Workers(policy, n);
+  T *data = v.data();
+  parallel::Run(threads, threads, [&](size_t i) {
+    size_t last = parallel::ChunkBegin(n, threads, i + 1);
+    for (size_t j = parallel::ChunkBegin(n, threads, i); j < last; ++j)
+      fn(data[j]);
+  });
+}
+
+template <class T, class F>
+void for_each(Vector<T> &v, F fn) {
+  for_each(execution::seq, v, fn);
+}
+
+template <class Policy, class T, class U, class F>
+void transform(const Policy &policy, const Vector<T> &src, Vector<U> &dst,
+               F op) {
+  size_t n = src.size();
+  if (dst.size() < n)
+    throw std::out_of_range("s21::transform: destination is too small");
+  unsigned threads = parallel::Workers(policy, n);
+  const T *in = src.data();
+  U *out = dst.data();
+  parallel::Run(threads, threads, [&](size_t i) {
+    size_t last = parallel::ChunkBegin(n, threads, i + 1);
+    for (size_t j = parallel::ChunkBegin(n, threads, i); j < last; ++j)
+      out[j] = op(in[j]);
+  });
+}
+
+template <class T, class U, class F>
+void transform(const Vector<T> &src, Vector<U> &dst, F op) {
+  transform(execution::seq, src, dst, op);
+}
+
+template <class Policy, class T, class R, class Op = std::plus<>>
+R reduce(const Policy &policy, const Vector<T> &v, R init, Op op = Op()) {
+  size_t n = v.size();
+  unsigned threads = parallel::Workers(policy, n);
+  const T *data = v.data();
+  if (threads <= 1) {
+    for (size_t i = 0; i < n; ++i) init = op(init, data[i]);
+    return init;
+  }
+  // Optional so that R need not be default constructible.
+  std::unique_ptr<std::optional<R>[]> partial(new std::optional<R>[threads]);
+  parallel::Run(threads, threads, [&](size_t i) {
+    size_t first = parallel::ChunkBegin(n, threads, i);
+    size_t last = parallel::ChunkBegin(n, threads, i + 1);
+    R acc = data[first];
+    for (size_t j = first + 1; j < last; ++j) acc = op(acc, data[j]);
+    partial[i].emplace(std::move(acc));
+  });
+  for (unsigned i = 0; i < threads; ++i) init = op(init, *partial[i]);
+  return init;
+}
+
+template <class T, class R, class Op = std::plus<>>
+R reduce(const Vector<T> &v, R init, Op op = Op()) {
+  return reduce(execution::seq, v, init, op);
+}
+
+namespace radix {
+template <class K>
+using Bits = typename std::conditional<
+    sizeof(K) <= 1, uint8_t,
+    typename std::conditional<
+        sizeof(K) <= 2, uint16_t,
+        typename std::conditional<sizeof(K) <= 4, uint32_t,
+                                  uint64_t>::type>::type>::type;
+
+// Maps a key to an unsigned integer with the same ordering.
+template <class K>
+Bits<K> ToBits(K key) {
+  static_assert(std::is_arithmetic<K>::value &&
+                    !std::is_same<K, bool>::value && sizeof(K) <= 8,
+                "s21::radix_sort: keys must be integers or floating point "
+                "of at most 64 bits");
+  constexpr Bits<K> kSign = Bits<K>(1) << (sizeof(K) * 8 - 1);
+  Bits<K> bits;
+  if constexpr (std::is_floating_point<K>::value) {
+    std::memcpy(&bits, &key, sizeof(K));
+    bits = (bits & kSign) ? Bits<K>(~bits) : Bits<K>(bits | kSign);
+  } else if constexpr (std::is_signed<K>::value) {
+    bits = Bits<K>(key) ^ kSign;
+  } else {
+    bits = key;
+  }
+  return bits;
+}
+
+// Stable LSD sort, one byte per pass. Passes in which every key has the
+// same byte are skipped.
+template <class T, class Proj>
+void Sort(Vector<T> &v, Proj proj) {
+  using Key = decltype(ToBits(proj(v[0])));
+  constexpr size_t kPasses = sizeof(Key);
+  size_t n = v.size();
+  if (n < 2) return;
+  std::unique_ptr<size_t[]> counts(new size_t[kPasses * 256]());
+  T *src = v.data();
+  for (size_t i = 0; i < n; ++i) {
+    Key key = ToBits(proj(src[i]));
+    for (size_t pass = 0; pass < kPasses; ++pass)
+      ++counts[pass * 256 + ((key >> (8 * pass)) & 0xFF)];
+  }
+  Vector<T> scratch;
+  T *dst = nullptr;
+  Key first = ToBits(proj(src[0]));
+  for (size_t pass = 0; pass < kPasses; ++pass) {
+    size_t *count = counts.get() + pass * 256;
+    if (count[(first >> (8 * pass)) & 0xFF] == n) continue;
+    if (!dst) {
+      scratch.reserve(n);
+      dst = scratch.data();
+    }
+    size_t offset = 0;
+    for (size_t b = 0; b < 256; ++b) {
+      size_t c = count[b];
+      count[b] = offset;
+      offset += c;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      Key key = ToBits(proj(src[i]));
+      dst[count[(key >> (8 * pass)) & 0xFF]++] = std::move(src[i]);
+    }
+    std::swap(src, dst);
+  }
+  if (src != v.data()) std::move(src, src + n, v.data());
+}
+}  // namespace radix
+
+template <class T>
+void radix_sort(Vector<T> &v) {
+  radix::Sort(v, [](const T &value) { return value; });
+}
+
+template <class T, class Proj>
+void radix_sort(Vector<T> &v, Proj key) {
+  radix::Sort(v, key);
+}
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_ALGORITHM_H_
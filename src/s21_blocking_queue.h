@@ -0,0 +1,199 @@
+#ifndef CONTAINERS_SRC_S21_BLOCKING_QUEUE_H_
+#define CONTAINERS_SRC_S21_BLOCKING_QUEUE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_vector.h"
+
+namespace s21 {
+// Bounded multi-producer, multi-consumer FIFO. Elements live in a ring over a
+// Vector allocated once, so push and pop never allocate. Producers wait while
+// the queue is full and consumers while it is empty. After close() pushes
+// fail, and pops drain what is left and then fail instead of waiting.
+template <typename T>
+class BlockingQueue {
+ public:
+  using value_type = T;
+  using const_reference = const T &;
+  using size_type = size_t;
+
+  explicit BlockingQueue(size_type capacity) : ring_(capacity) {
+    if (!capacity)
+      throw std::invalid_argument("s21::BlockingQueue: zero capacity");
+  }
+
+  BlockingQueue(const BlockingQueue &) = delete;
+  BlockingQueue &operator=(const BlockingQueue &) = delete;
+
+  // Waits for room; returns false if the queue is closed.
+  bool push(const_reference value) { return Push(value, nullptr); }
+  bool push(value_type &&value) { return Push(std::move(value), nullptr); }
+
+  // Returns false at once if the queue is full or closed.
+  bool try_push(const_reference value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_ || count_ == ring_.size()) return false;
+    Enqueue(lock, value);
+    return true;
+  }
+
+  template <class Rep, class Period>
+  bool push_for(const_reference value,
+                const std::chrono::duration<Rep, Period> &timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    return Push(value, &deadline);
+  }
+
+  // Waits for an element; returns false once the queue is closed and empty.
+  bool pop(value_type &value) { return Pop(value, nullptr); }
+
+  bool try_pop(value_type &value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!count_) return false;
+    Dequeue(lock, value);
+    return true;
+  }
+
+  template <class Rep, class Period>
+  bool pop_for(value_type &value,
+               const std::chrono::duration<Rep, Period> &timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    return Pop(value, &deadline);
+  }
+
+  // Waits for at least one element, then moves up to max of them to the end
+  // of out under a single lock acquisition. Returns the number moved, which
+  // is 0 only once the queue is closed and empty, or at once if max is 0.
+  size_type pop_batch(size_type max, Vector<value_type> &out) {
+    if (!max) return 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    Wait(lock, not_empty_, consumers_waiting_, nullptr,
+         [this] { return count_ || closed_; });
+    size_type n = count_ < max ? count_ : max;
+    for (size_type i = 0; i < n; ++i) {
+      out.push_back(std::move(ring_[head_]));
+      head_ = Advance(head_);
+    }
+    count_ -= n;
+    bool wake = producers_waiting_ && n;
+    lock.unlock();
+    if (wake) {
+      if (n == 1)
+        not_full_.notify_one();
+      else
+        not_full_.notify_all();
+    }
+    return n;
+  }
+
+  // Wakes every waiting thread. Elements already queued can still be popped.
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    not_empty_.notify_all();
+    not_full_.notify_all();
+  }
+
+  bool closed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+  }
+
+  size_type size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_;
+  }
+
+  bool empty() const { return !size(); }
+  size_type capacity() const { return ring_.size(); }
+
+ private:
+  using Deadline = std::chrono::steady_clock::time_point;
+
+  mutable std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  Vector<value_type> ring_;
+  size_type head_ = 0;
+  size_type count_ = 0;
+  bool closed_ = false;
+  // Threads blocked on each condition. Notifying costs a system call, so it
+  // is skipped when nobody waits.
+  size_type producers_waiting_ = 0;
+  size_type consumers_waiting_ = 0;
+
+  size_type Advance(size_type pos) const {
+    return pos + 1 == ring_.size() ? 0 : pos + 1;
+  }
+
+  template <class U>
+  bool Push(U &&value, const Deadline *deadline) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!Wait(lock, not_full_, producers_waiting_, deadline,
+              [this] { return closed_ || count_ < ring_.size(); }))
+      return false;
+    if (closed_) return false;
+    Enqueue(lock, std::forward<U>(value));
+    return true;
+  }
+
+  bool Pop(value_type &value, const Deadline *deadline) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!Wait(lock, not_empty_, consumers_waiting_, deadline,
+              [this] { return count_ || closed_; }))
+      return false;
+    if (!count_) return false;
+    Dequeue(lock, value);
+    return true;
+  }
+
+  // Returns false if the deadline passed before ready() held.
+  template <class Ready>
+  bool Wait(std::unique_lock<std::mutex> &lock,
+            std::condition_variable &condition, size_type &waiting,
+            const Deadline *deadline, Ready ready) {
+    while (!ready()) {
+      ++waiting;
+      bool timed_out = false;
+      if (!deadline)
+        condition.wait(lock);
+      else
+        timed_out = condition.wait_until(lock, *deadline) ==
+                    std::cv_status::timeout;
+      --waiting;
+      if (timed_out) return ready();
+    }
+    return true;
+  }
+
+  // Both release the lock before notifying, so the woken thread does not
+  // immediately block on the mutex.
+  template <class U>
+  void Enqueue(std::unique_lock<std::mutex> &lock, U &&value) {
+    size_type tail = head_ + count_;
+    if (tail >= ring_.size()) tail -= ring_.size();
+    ring_[tail] = std::forward<U>(value);
+    ++count_;
+    bool wake = consumers_waiting_;
+    lock.unlock();
+    if (wake) not_empty_.notify_one();
+  }
+
+  void Dequeue(std::unique_lock<std::mutex> &lock, value_type &value) {
+    value = std::move(ring_[head_]);
+    head_ = Advance(head_);
+    --count_;
+    bool wake = producers_waiting_;
+    lock.unlock();
+    if (wake) not_full_.notify_one();
+  }
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_BLOCKING_QUEUE_H_
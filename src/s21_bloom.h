@@ -0,0 +1,127 @@
+#ifndef CONTAINERS_SRC_S21_BLOOM_H_
+#define CONTAINERS_SRC_S21_BLOOM_H_
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "s21_simd.h"
+#include "s21_vector.h"
+
+namespace s21 {
+// Split-block Bloom filter: a key sets one bit in each of the eight 32-bit
+// lanes of a single 32-byte block, so a probe reads one aligned block that
+// never straddles a cache line and AVX2 tests all eight bits at once. Keys
+// are given as 64-bit hashes: the high half picks the block, the low half
+// the bits. With 10 bits per key about 1% of absent keys pass.
+class BloomFilter {
+ public:
+  static constexpr size_t kBitsPerKey = 10;
+
+  BloomFilter() {}
+
+  // An empty filter sized for capacity keys; capacity 0 disables it.
+  explicit BloomFilter(size_t capacity) { Reset(capacity); }
+
+  void Reset(size_t capacity) {
+    size_t blocks = capacity ? (capacity * kBitsPerKey + 255) / 256 : 0;
+    Vector<Block> fresh(blocks);
+    blocks_.swap(fresh);
+    capacity_ = capacity;
+  }
+
+  bool enabled() const { return capacity_; }
+
+  // Keys the filter was sized for; past this the false positive rate grows.
+  size_t capacity() const { return capacity_; }
+
+  void Insert(uint64_t hash) {
+    Block &block = blocks_[BlockIndex(hash)];
+    for (int i = 0; i < 8; ++i) block.lanes_[i] |= Bit(hash, i);
+  }
+
+  // False only if hash was never inserted.
+  bool MayContain(uint64_t hash,
+                  simd::Level level = simd::ActiveLevel()) const {
+    const Block &block = blocks_[BlockIndex(hash)];
+#ifdef S21_SIMD_X86
+    if (level == simd::Level::kAvx2)
+      return MayContainAvx2(block.lanes_, (uint32_t)hash);
+#endif
+    (void)level;
+    for (int i = 0; i < 8; ++i)
+      if (!(block.lanes_[i] & Bit(hash, i))) return false;
+    return true;
+  }
+
+  void swap(BloomFilter &other) {
+    blocks_.swap(other.blocks_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+ private:
+  struct alignas(32) Block {
+    uint32_t lanes_[8] = {};
+  };
+
+  static constexpr uint32_t kSalt[8] = {
+      0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+      0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+
+  Vector<Block> blocks_;
+  size_t capacity_ = 0;
+
+  size_t BlockIndex(uint64_t hash) const {
+    return (size_t)(((hash >> 32) * blocks_.size()) >> 32);
+  }
+
+  static uint32_t Bit(uint64_t hash, int lane) {
+    return uint32_t(1) << (((uint32_t)hash * kSalt[lane]) >> 27);
+  }
+
+#ifdef S21_SIMD_X86
+  __attribute__((target("avx2"))) static bool MayContainAvx2(
+      const uint32_t *lanes, uint32_t hash) {
+    const __m256i salt =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(kSalt));
+    __m256i product = _mm256_mullo_epi32(_mm256_set1_epi32(hash), salt);
+    __m256i bits = _mm256_sllv_epi32(_mm256_set1_epi32(1),
+                                     _mm256_srli_epi32(product, 27));
+    __m256i block =
+        _mm256_load_si256(reinterpret_cast<const __m256i *>(lanes));
+    return _mm256_testc_si256(block, bits);
+  }
+#endif
+};
+
+// Finalizer of MurmurHash3: std::hash is the identity for integers, and the
+// filter needs all 64 bits mixed.
+inline uint64_t BloomHash(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdu;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb93fe53a87c5u;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+template <class K>
+uint64_t BloomHashOf(const K &key) {
+  return BloomHash(std::hash<K>()(key));
+}
+
+// The part of a stored value a filter is built over: the key of a map pair.
+template <class V>
+struct BloomKeyOf {
+  using type = V;
+  static const V &Get(const V &value) { return value; }
+};
+
+template <class A, class B>
+struct BloomKeyOf<std::pair<A, B>> {
+  using type = A;
+  static const A &Get(const std::pair<A, B> &value) { return value.first; }
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_BLOOM_H_
@@ -1,11 +1,21 @@
 #ifndef CONTAINERS_SRC_S21_BTREE_H_
 #define CONTAINERS_SRC_S21_BTREE_H_
 
+#include <algorithm>
 #include <iostream>
 #include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 
+#include "s21_bloom.h"
 #include "s21_comparators.h"
+#include "s21_instrumentation.h"
+#include "s21_node_arena.h"
+#include "s21_tree_links.h"
+#include "s21_vector.h"
 
 template <class Key, class Compare = s21::SingleComparator<Key>>
 class BTree {
@@ -23,7 +33,7 @@ class BTree {
       parent_ = parent;
       right_ = right;
       left_ = left;
-      data_ = key;
+      data_ = std::move(key);
     };
     ~Node(){};
 
@@ -57,17 +67,7 @@ class BTree {
     value_type &operator*() const { return address_->data_; }
 
     Iterator &operator++() {
-      if (this->address_->right_) {
-        this->address_ = this->address_->right_;
-        while (this->address_->left_) this->address_ = this->address_->left_;
-      } else if (this->address_->parent_->left_ == this->address_) {
-        this->address_ = this->address_->parent_;
-      } else {
-        key_type tmp = this->address_->data_;
-        do {
-          this->address_ = this->address_->parent_;
-        } while (comparator_.GreaterThan(tmp, this->address_->data_));
-      }
+      address_ = s21::TreeNext(address_);
       return *this;
     }
 
@@ -78,17 +78,7 @@ class BTree {
     }
 
     Iterator &operator--() {
-      if (this->address_->left_) {
-        this->address_ = this->address_->left_;
-        while (this->address_->right_) this->address_ = this->address_->right_;
-      } else if (this->address_->parent_->right_ == this->address_) {
-        this->address_ = this->address_->parent_;
-      } else {
-        key_type tmp = this->address_->data_;
-        do {
-          this->address_ = this->address_->parent_;
-        } while (comparator_.LessThan(tmp, this->address_->data_));
-      }
+      address_ = s21::TreePrev(address_);
       return *this;
     }
 
@@ -129,7 +119,6 @@ class BTree {
     }
 
    private:
-    key_compare comparator_;
     Node *address_;
   };
 
@@ -155,17 +144,7 @@ class BTree {
     const_reference operator*() const { return address_->data_; }
 
     ConstIterator &operator++() {
-      if (this->address_->right_) {
-        this->address_ = this->address_->right_;
-        while (this->address_->left_) this->address_ = this->address_->left_;
-      } else if (this->address_->parent_->left_ == this->address_) {
-        this->address_ = this->address_->parent_;
-      } else {
-        key_type tmp = this->address_->data_;
-        do {
-          this->address_ = this->address_->parent_;
-        } while (comparator_.GreaterThan(tmp, this->address_->data_));
-      }
+      address_ = s21::TreeNext(address_);
       return *this;
     }
 
@@ -176,17 +155,7 @@ class BTree {
     }
 
     ConstIterator &operator--() {
-      if (this->address_->left_) {
-        this->address_ = this->address_->left_;
-        while (this->address_->right_) this->address_ = this->address_->right_;
-      } else if (this->address_->parent_->right_ == this->address_) {
-        this->address_ = this->address_->parent_;
-      } else {
-        key_type tmp = this->address_->data_;
-        do {
-          this->address_ = this->address_->parent_;
-        } while (comparator_.LessThan(tmp, this->address_->data_));
-      }
+      address_ = s21::TreePrev(address_);
       return *this;
     }
 
@@ -227,7 +196,6 @@ class BTree {
     };
 
    private:
-    key_compare comparator_;
     Node *address_;
   };
 
@@ -236,16 +204,14 @@ class BTree {
 
   iterator begin() {
     iterator tmp(begin_null_);
-    if (size_) ++tmp;
-    return tmp;
+    return ++tmp;
   }
 
   iterator end() { return iterator(end_null_); }
 
   const_iterator cbegin() const {
     const_iterator tmp(begin_null_);
-    if (size_) ++tmp;
-    return tmp;
+    return ++tmp;
   }
 
   const_iterator cend() const { return const_iterator(end_null_); }
@@ -260,17 +226,76 @@ class BTree {
 
   void clear() {
     if (size_) {
-      iterator it = begin();
-      while (it != end()) {
-        iterator tmp = it + 1;
-        erase(it);
-        it = tmp;
-      }
+      DetachNulls();
+      DestroyNodes(root_);
+      root_ = nullptr;
+      size_ = 0;
+      AttachNulls();
+      blocks_.clear();
     }
+    if (bloom_hash_) RebuildBloom();
   }
 
   void erase(iterator pos) { DeleteOrExtract(pos, true); }
 
+  // Number of levels; 0 for an empty tree and 1 for a lone root.
+  size_type height() {
+    size_type height = 0;
+    ForEachDepth([&height](size_type depth) {
+      if (depth + 1 > height) height = depth + 1;
+    });
+    return height;
+  }
+
+  // Mean number of edges between the root and a node.
+  double average_depth() {
+    size_type total = 0;
+    ForEachDepth([&total](size_type depth) { total += depth; });
+    return size_ ? (double)total / size_ : 0.0;
+  }
+
+  // Element d is the number of nodes d edges below the root.
+  s21::Vector<size_type> depth_histogram() {
+    s21::Vector<size_type> histogram(height());
+    ForEachDepth([&histogram](size_type depth) { ++histogram[depth]; });
+    return histogram;
+  }
+
+  // Moves every node into one contiguous block in breadth-first order, so
+  // the top levels share cache lines. Invalidates all iterators.
+  void compact() {
+    if (!size_) return;
+    DetachNulls();
+    Node *block = blocks_.Allocate<Node>(size_);
+    size_type tail = 0;
+    root_ = Relocate(root_, block, tail, nullptr);
+    for (size_type i = 0; i < tail; ++i) {
+      Node *old = block[i].left_;
+      block[i].left_ = Relocate(old->left_, block, tail, block + i);
+      block[i].right_ = Relocate(old->right_, block, tail, block + i);
+      blocks_.Free(old);
+    }
+    AttachNulls();
+  }
+
+  // Day-Stout-Warren: flattens the tree into a right vine and folds it back
+  // into a complete tree. O(n) time, O(1) extra space; iterators stay valid.
+  void rebalance() {
+    if (size_ < 3) return;
+    DetachNulls();
+    Node *pseudo_root = begin_null_;
+    pseudo_root->right_ = root_;
+    root_->parent_ = pseudo_root;
+    TreeToVine(pseudo_root);
+    size_type full = 1;
+    while (full * 2 + 1 <= size_) full = full * 2 + 1;
+    Compress(pseudo_root, size_ - full);
+    for (size_type n = full; n > 1; n /= 2) Compress(pseudo_root, n / 2);
+    root_ = pseudo_root->right_;
+    pseudo_root->right_ = nullptr;
+    AttachNulls();
+  }
+
   void swap(BTree &other) {
     Node *tmp_root = this->root_;
     Node *tmp_end_null = this->end_null_;
@@ -284,14 +309,106 @@ class BTree {
     other.end_null_ = tmp_end_null;
     other.begin_null_ = tmp_begin_null;
     other.size_ = tmp;
+    blocks_.swap(other.blocks_);
+    SwapBloom(other);
   }
 
+  // Keeps a Bloom filter of the keys beside the tree, so looking up an
+  // absent key usually returns without descending. Costs about 10 bits per
+  // key and a hash per insert. The filter is rebuilt when the tree outgrows
+  // it, on clear(), and once erased keys outnumber live ones. Copies start
+  // with the filter off. Only for the default comparators: the filter
+  // hashes keys with std::hash, so a comparator that treats different keys
+  // as equal would make present keys look absent.
+  void enable_bloom(bool on) {
+    static_assert(s21::IsDefaultComparator<key_type, Compare>::value,
+                  "enable_bloom needs the default comparator");
+    bloom_hash_ = on ? &s21::BloomHashOf<bloom_key> : nullptr;
+    if (on)
+      RebuildBloom();
+    else
+      bloom_.Reset(0);
+  }
+
+  bool bloom_enabled() const { return bloom_hash_; }
+
  protected:
   size_type size_ = 0;
   Node *root_ = nullptr;
   Node *begin_null_;
   Node *end_null_;
   key_compare comparator_;
+  // Blocks made by compact(), here or in containers nodes came from.
+  s21::arena::Blocks blocks_;
+
+  // Called after nodes of other were moved into this tree.
+  void ShareBlocks(BTree &other) {
+    blocks_.Share(other.blocks_);
+    if (!other.size_) other.blocks_.clear();
+  }
+
+  using bloom_key = typename s21::BloomKeyOf<key_type>::type;
+  static constexpr size_type kMinBloomCapacity = 1024;
+
+  s21::BloomFilter bloom_;
+  uint64_t (*bloom_hash_)(const bloom_key &) = nullptr;
+  size_type bloom_stale_ = 0;
+
+  // True if key is certainly absent. Probes of another type than the key
+  // skip the filter, except text probes for std::string keys, whose hash
+  // std::hash<std::string_view> is guaranteed to match.
+  template <class K>
+  bool BloomRejects(const K &key) const {
+    if (!bloom_hash_) return false;
+    if constexpr (std::is_same<K, bloom_key>::value) {
+      return !bloom_.MayContain(bloom_hash_(key));
+    } else if constexpr (std::is_same<bloom_key, std::string>::value &&
+                         std::is_convertible<const K &,
+                                             std::string_view>::value) {
+      return !bloom_.MayContain(
+          s21::BloomHash(std::hash<std::string_view>()(key)));
+    } else {
+      return false;
+    }
+  }
+
+  void BloomAdd(const key_type &key) {
+    if (!bloom_hash_) return;
+    if (size_ > bloom_.capacity())
+      RebuildBloom();
+    else
+      bloom_.Insert(bloom_hash_(s21::BloomKeyOf<key_type>::Get(key)));
+  }
+
+  // Bloom filters cannot forget keys; erased ones only raise the false
+  // positive rate until the next rebuild.
+  void BloomErased(size_type count) {
+    if (!bloom_hash_) return;
+    bloom_stale_ += count;
+    if (bloom_stale_ > std::max(size_, kMinBloomCapacity)) RebuildBloom();
+  }
+
+  void RebuildBloom() {
+    bloom_.Reset(std::max(2 * size_, kMinBloomCapacity));
+    bloom_stale_ = 0;
+    if (!size_) return;
+    for (iterator it = begin(); it != end(); ++it)
+      bloom_.Insert(bloom_hash_(s21::BloomKeyOf<key_type>::Get(*it)));
+  }
+
+  // Turns the filter on in to if it is on here. Skips enable_bloom's check:
+  // the filter can only be on if the comparator passed it.
+  void InheritBloom(BTree &to) const {
+    if (!bloom_hash_) return;
+    to.bloom_hash_ = bloom_hash_;
+    to.RebuildBloom();
+  }
+
+  void SwapBloom(BTree &other) {
+    bloom_.swap(other.bloom_);
+    std::swap(bloom_hash_, other.bloom_hash_);
+    std::swap(bloom_stale_, other.bloom_stale_);
+  }
 
   void ChangeChildOfParent(Node *parent, Node *old_child, Node *new_child) {
     parent->left_ == old_child ? parent->left_ = new_child
@@ -300,9 +417,8 @@ class BTree {
 
   void DeleteOrExtract(iterator pos, bool del) {
     if (pos.node() && pos.node() != end_null_ && pos.node() != begin_null_) {
-      key_type tmp = *pos;
-      Node *node = root_;
-      Node *parent = Search(tmp, node);
+      Node *node = pos.node();
+      Node *parent = node->parent_;
 
       if (IsLeaf(node)) {
         DeleteLeaf(node);
@@ -321,54 +437,195 @@ class BTree {
           }
         }
       }
-      if (del) delete node;
+      if (del) {
+        blocks_.Free(node);
+        S21_COUNT(tree_node_frees, 1);
+      }
+      S21_COUNT(tree_erases, 1);
       --size_;
+      BloomErased(1);
     }
   }
 
   std::pair<iterator, bool> InsertOrPaste(const key_type &key,
                                           Node *node = nullptr) {
-    Node *insertible = !node ? new Node(key) : node;
+    Node *insertible = !node ? NewNode(key) : node;
     std::pair<iterator, bool> pair(iterator(insertible), true);
 
     if (!root_) {
-      root_ = insertible;
-      insertible->right_ = end_null_;
-      insertible->left_ = begin_null_;
-      end_null_->parent_ = insertible;
-      begin_null_->parent_ = insertible;
-      end_null_->right_ = end_null_;
-      begin_null_->left_ = begin_null_;
+      LinkRoot(insertible);
+    } else if (comparator_.GreaterThan(key, end_null_->parent_->data_)) {
+      LinkRight(end_null_->parent_, insertible);
     } else {
       Node *tmp = root_;
       Node *parent = Search(key, tmp);
-      if (tmp == end_null_) {
-        parent->right_ = insertible;
-        insertible->parent_ = parent;
-        insertible->left_ = nullptr;
-        insertible->right_ = end_null_;
-        end_null_->parent_ = insertible;
-      } else if (tmp == begin_null_) {
-        parent->left_ = insertible;
-        insertible->parent_ = parent;
-        insertible->right_ = nullptr;
-        insertible->left_ = begin_null_;
-        begin_null_->parent_ = insertible;
-      } else if (!tmp) {
-        comparator_.LessThan(key, parent->data_) ? parent->left_ = insertible
-                                                 : parent->right_ = insertible;
-        insertible->parent_ = parent;
-        insertible->left_ = insertible->right_ = nullptr;
+      if (tmp == end_null_ || tmp == begin_null_ || !tmp) {
+        if (comparator_.LessThan(key, parent->data_))
+          LinkLeft(parent, insertible);
+        else
+          LinkRight(parent, insertible);
       } else {
         pair.first = iterator(tmp);
         pair.second = false;
-        if (!node) delete insertible;
+        if (!node) {
+          blocks_.Free(insertible);
+          S21_COUNT(tree_node_frees, 1);
+        }
       }
     }
-    if (pair.second) ++size_;
+    if (pair.second) {
+      S21_COUNT(tree_inserts, 1);
+      ++size_;
+      BloomAdd(key);
+    }
     return pair;
   }
 
+  iterator InsertEqual(const key_type &key, Node *node = nullptr) {
+    Node *insertible = !node ? NewNode(key) : node;
+    if (!root_) {
+      LinkRoot(insertible);
+    } else if (comparator_.GreaterOrEquals(key, end_null_->parent_->data_)) {
+      LinkRight(end_null_->parent_, insertible);
+    } else {
+      Node *parent = root_;
+      Node *tmp = root_;
+      while (tmp && tmp != begin_null_ && tmp != end_null_) {
+        parent = tmp;
+        tmp = comparator_.LessThan(key, tmp->data_) ? tmp->left_ : tmp->right_;
+      }
+      if (comparator_.LessThan(key, parent->data_))
+        LinkLeft(parent, insertible);
+      else
+        LinkRight(parent, insertible);
+    }
+    S21_COUNT(tree_inserts, 1);
+    ++size_;
+    BloomAdd(key);
+    return iterator(insertible);
+  }
+
+  // The node equivalent to key, or nullptr. key may be of any type the
+  // comparator orders against key_type in both directions.
+  template <class K>
+  Node *FindNode(const K &key) {
+    Node *node = root_;
+    size_type depth = 0;
+    while (node && node != begin_null_ && node != end_null_) {
+      if (comparator_.LessThan(key, node->data_))
+        node = node->left_;
+      else if (comparator_.LessThan(node->data_, key))
+        node = node->right_;
+      else
+        break;
+      ++depth;
+    }
+    S21_COUNT(tree_searches, 1);
+    S21_COUNT(tree_search_steps, depth);
+    S21_COUNT_MAX(tree_max_search_depth, depth);
+    return node != begin_null_ && node != end_null_ ? node : nullptr;
+  }
+
+  template <class K>
+  Node *LowerBound(const K &key) {
+    Node *result = end_null_;
+    Node *tmp = root_;
+    while (tmp && tmp != begin_null_ && tmp != end_null_) {
+      if (comparator_.LessThan(tmp->data_, key)) {
+        tmp = tmp->right_;
+      } else {
+        result = tmp;
+        tmp = tmp->left_;
+      }
+    }
+    return result;
+  }
+
+  template <class K>
+  Node *UpperBound(const K &key) {
+    Node *result = end_null_;
+    Node *tmp = root_;
+    while (tmp && tmp != begin_null_ && tmp != end_null_) {
+      if (comparator_.LessThan(key, tmp->data_)) {
+        result = tmp;
+        tmp = tmp->left_;
+      } else {
+        tmp = tmp->right_;
+      }
+    }
+    return result;
+  }
+
+  std::pair<iterator, bool> InsertWithHint(iterator hint, const key_type &key,
+                                           Node *node = nullptr) {
+    Node *pos = hint.node();
+    if (!size_ || !pos || pos == begin_null_) return InsertOrPaste(key, node);
+
+    Node *parent = nullptr;
+    bool left = false;
+    if (pos == end_null_ || comparator_.LessThan(key, pos->data_)) {
+      Node *prev = (hint - 1).node();
+      if (prev == begin_null_) {
+        parent = pos;
+        left = true;
+      } else if (comparator_.LessThan(prev->data_, key)) {
+        if (pos != end_null_ && (!pos->left_ || pos->left_ == begin_null_)) {
+          parent = pos;
+          left = true;
+        } else {
+          parent = prev;
+        }
+      }
+    } else if (comparator_.GreaterThan(key, pos->data_)) {
+      Node *next = (hint + 1).node();
+      if (next == end_null_ || comparator_.LessThan(key, next->data_)) {
+        if (!pos->right_ || pos->right_ == end_null_) {
+          parent = pos;
+        } else {
+          parent = next;
+          left = true;
+        }
+      }
+    } else {
+      return std::pair<iterator, bool>(hint, false);
+    }
+    if (!parent) return InsertOrPaste(key, node);
+
+    Node *insertible = !node ? NewNode(key) : node;
+    left ? LinkLeft(parent, insertible) : LinkRight(parent, insertible);
+    S21_COUNT(tree_inserts, 1);
+    ++size_;
+    BloomAdd(key);
+    return std::pair<iterator, bool>(iterator(insertible), true);
+  }
+
+  void LinkRoot(Node *insertible) {
+    root_ = insertible;
+    insertible->parent_ = nullptr;
+    insertible->right_ = end_null_;
+    insertible->left_ = begin_null_;
+    end_null_->parent_ = insertible;
+    begin_null_->parent_ = insertible;
+    end_null_->right_ = end_null_;
+    begin_null_->left_ = begin_null_;
+  }
+
+  void LinkLeft(Node *parent, Node *insertible) {
+    insertible->parent_ = parent;
+    insertible->right_ = nullptr;
+    insertible->left_ = parent->left_;
+    if (parent->left_ == begin_null_) begin_null_->parent_ = insertible;
+    parent->left_ = insertible;
+  }
+
+  void LinkRight(Node *parent, Node *insertible) {
+    insertible->parent_ = parent;
+    insertible->left_ = nullptr;
+    insertible->right_ = parent->right_;
+    if (parent->right_ == end_null_) end_null_->parent_ = insertible;
+    parent->right_ = insertible;
+  }
+
   void DeleteLeaf(Node *node) {
     ChangeChildOfParent(node->parent_, node, nullptr);
   }
@@ -472,18 +729,68 @@ class BTree {
 
   Node *Search(const key_type &key, Node *&tmp_node) {
     Node *parent = nullptr;
+    size_type depth = 0;
     while (tmp_node != nullptr && tmp_node != begin_null_ &&
            tmp_node != end_null_ &&
            comparator_.NotEquals(key, tmp_node->data_)) {
+      ++depth;
       parent = tmp_node;
       if (comparator_.LessThan(key, tmp_node->data_))
         tmp_node = tmp_node->left_;
       else if (comparator_.GreaterThan(key, tmp_node->data_))
         tmp_node = tmp_node->right_;
     }
+    S21_COUNT(tree_searches, 1);
+    S21_COUNT(tree_search_steps, depth);
+    S21_COUNT_MAX(tree_max_search_depth, depth);
     return parent;
   }
 
+  // Looks up a batch of keys in groups of kSearchGroup. Each round moves
+  // every unfinished key of the group one level down and prefetches the
+  // child it goes to, so the cache misses of different keys overlap instead
+  // of forming one dependent chain per key. Calls found(i, node) once per
+  // key, with nullptr for a missing key. less must order a Probe against
+  // key_type both ways.
+  template <class Probe, class Less, class Found>
+  void SearchMany(const Probe *keys, size_type n, Less less, Found found) {
+    static constexpr size_type kSearchGroup = 16;
+    Node *cursor[kSearchGroup];
+    size_type active[kSearchGroup];
+    for (size_type first = 0; first < n; first += kSearchGroup) {
+      size_type left = std::min(kSearchGroup, n - first);
+      for (size_type i = 0; i < left; ++i) {
+        cursor[i] = root_;
+        active[i] = i;
+      }
+      while (left) {
+        for (size_type j = 0; j < left;) {
+          size_type i = active[j];
+          Node *node = cursor[i];
+          const Probe &key = keys[first + i];
+          Node *next = nullptr;
+          if (node && node != begin_null_ && node != end_null_) {
+            if (less(key, node->data_))
+              next = node->left_;
+            else if (less(node->data_, key))
+              next = node->right_;
+            else
+              next = node;
+          }
+          if (next && next != node) {
+            __builtin_prefetch(next);
+            cursor[i] = next;
+            ++j;
+          } else {
+            found(first + i, next);
+            active[j] = active[--left];
+          }
+        }
+      }
+    }
+    S21_COUNT(tree_searches, n);
+  }
+
   bool IsLeaf(Node *check) {
     bool i = false;
     if (check->left_ == nullptr && check->right_ == nullptr) i = true;
@@ -498,11 +805,266 @@ class BTree {
   }
 
   Node *GetMax(Node *start) {
-    return start->right_ == nullptr ? start : GetMax(start->right_);
+    while (start->right_) start = start->right_;
+    return start;
   }
 
   Node *GetMin(Node *start) {
-    return start->left_ == nullptr ? start : GetMin(start->left_);
+    while (start->left_) start = start->left_;
+    return start;
+  }
+
+  // Moves old into the next free slot of block. The copy keeps old in its
+  // left link until compact() has relocated old's children.
+  Node *Relocate(Node *old, Node *block, size_type &tail, Node *parent) {
+    if (!old) return nullptr;
+    return new (block + tail++)
+        Node(std::move(old->data_), nullptr, old, parent);
+  }
+
+  Node *RealChild(Node *child) {
+    return child == begin_null_ || child == end_null_ ? nullptr : child;
+  }
+
+  // Calls fn(depth) for every node, walking parent links so no stack is
+  // needed.
+  template <class F>
+  void ForEachDepth(F fn) {
+    Node *prev = nullptr;
+    Node *node = root_;
+    size_type depth = 0;
+    while (node) {
+      Node *left = RealChild(node->left_);
+      Node *right = RealChild(node->right_);
+      Node *next = node->parent_;
+      if (prev == node->parent_) {
+        fn(depth);
+        if (left)
+          next = left;
+        else if (right)
+          next = right;
+      } else if (left && prev == left && right) {
+        next = right;
+      }
+      if (next == node->parent_)
+        --depth;
+      else
+        ++depth;
+      prev = node;
+      node = next;
+    }
+  }
+
+  void RotateRight(Node *parent, Node *node) {
+    Node *left = node->left_;
+    node->left_ = left->right_;
+    if (left->right_) left->right_->parent_ = node;
+    left->right_ = node;
+    node->parent_ = left;
+    parent->right_ = left;
+    left->parent_ = parent;
+  }
+
+  void RotateLeft(Node *parent, Node *node) {
+    Node *right = node->right_;
+    node->right_ = right->left_;
+    if (right->left_) right->left_->parent_ = node;
+    right->left_ = node;
+    node->parent_ = right;
+    parent->right_ = right;
+    right->parent_ = parent;
+  }
+
+  void TreeToVine(Node *pseudo_root) {
+    Node *tail = pseudo_root;
+    while (Node *rest = tail->right_) {
+      if (rest->left_)
+        RotateRight(tail, rest);
+      else
+        tail = rest;
+    }
+  }
+
+  void Compress(Node *pseudo_root, size_type count) {
+    Node *scanner = pseudo_root;
+    for (size_type i = 0; i < count; ++i) {
+      RotateLeft(scanner, scanner->right_);
+      scanner = scanner->right_;
+    }
+  }
+
+  void DetachNulls() {
+    if (root_) {
+      begin_null_->parent_->left_ = nullptr;
+      end_null_->parent_->right_ = nullptr;
+    }
+  }
+
+  void AttachNulls() {
+    end_null_->right_ = end_null_;
+    begin_null_->left_ = begin_null_;
+    if (root_) {
+      root_->parent_ = nullptr;
+      Node *min = GetMin(root_);
+      Node *max = GetMax(root_);
+      min->left_ = begin_null_;
+      begin_null_->parent_ = min;
+      max->right_ = end_null_;
+      end_null_->parent_ = max;
+    } else {
+      begin_null_->parent_ = end_null_;
+      end_null_->parent_ = begin_null_;
+    }
+  }
+
+  template <class K>
+  void SplitNodes(Node *node, const K &key, Node *&lower, Node *&upper) {
+    Node **lower_slot = &lower;
+    Node **upper_slot = &upper;
+    Node *lower_parent = nullptr;
+    Node *upper_parent = nullptr;
+    while (node) {
+      if (comparator_.LessThan(node->data_, key)) {
+        *lower_slot = node;
+        node->parent_ = lower_parent;
+        lower_parent = node;
+        lower_slot = &node->right_;
+        node = node->right_;
+      } else {
+        *upper_slot = node;
+        node->parent_ = upper_parent;
+        upper_parent = node;
+        upper_slot = &node->left_;
+        node = node->left_;
+      }
+    }
+    *lower_slot = nullptr;
+    *upper_slot = nullptr;
+  }
+
+  // The maximum of lower becomes the new root, so repeated concatenation
+  // grows the depth by at most one level each time.
+  Node *ConcatNodes(Node *lower, Node *upper) {
+    if (!lower) return upper;
+    if (!upper) return lower;
+    Node *max = GetMax(lower);
+    if (max != lower) {
+      max->parent_->right_ = max->left_;
+      if (max->left_) max->left_->parent_ = max->parent_;
+      max->left_ = lower;
+      lower->parent_ = max;
+    }
+    max->right_ = upper;
+    upper->parent_ = max;
+    max->parent_ = nullptr;
+    return max;
+  }
+
+  Node *NewNode(const key_type &key) {
+    S21_COUNT(tree_node_allocations, 1);
+    return new Node(key);
+  }
+
+  size_type DestroyNodes(Node *node) {
+    size_type count = 0;
+    while (node) {
+      if (node->left_) {
+        Node *left = node->left_;
+        node->left_ = left->right_;
+        left->right_ = node;
+        node = left;
+      } else {
+        Node *right = node->right_;
+        blocks_.Free(node);
+        node = right;
+        ++count;
+      }
+    }
+    S21_COUNT(tree_node_frees, count);
+    return count;
+  }
+
+  // Relinking is O(depth), but nodes carry no subtree sizes, so the sizes
+  // of the two halves are found by walking them from the split point in
+  // lockstep: O(min(k, n - k)) for k moved elements.
+  template <class K>
+  void SplitTree(const K &key, BTree &upper) {
+    if (root_ && !upper.root_) {
+      DetachNulls();
+      SplitNodes(root_, key, root_, upper.root_);
+      AttachNulls();
+      upper.AttachNulls();
+      size_type moved = CountUpper(upper);
+      size_ -= moved;
+      upper.blocks_.Share(blocks_);
+      upper.size_ = moved;
+      BloomErased(moved);
+      InheritBloom(upper);
+    }
+  }
+
+  // Number of nodes in upper, the part split off this tree, which still
+  // counts them in size_.
+  size_type CountUpper(BTree &upper) {
+    iterator up = upper.begin();
+    iterator down = end();
+    for (size_type steps = 0;; ++steps) {
+      if (up == upper.end()) return steps;
+      if (down == begin()) return size_ - steps;
+      ++up;
+      --down;
+    }
+  }
+
+  void JoinTree(BTree &other) {
+    if (!other.root_) return;
+    if (!root_) {
+      swap(other);
+      SwapBloom(other);
+      if (bloom_hash_) RebuildBloom();
+      return;
+    }
+    if (!comparator_.LessThan(end_null_->parent_->data_,
+                              other.begin_null_->parent_->data_))
+      throw std::invalid_argument("s21::join: keys of other must be greater");
+    if (bloom_hash_)
+      for (iterator it = other.begin(); it != other.end(); ++it)
+        bloom_.Insert(bloom_hash_(s21::BloomKeyOf<key_type>::Get(*it)));
+    other.DetachNulls();
+    Node *max = end_null_->parent_;
+    max->right_ = other.root_;
+    other.root_->parent_ = max;
+    Node *other_max = other.GetMax(other.root_);
+    other_max->right_ = end_null_;
+    end_null_->parent_ = other_max;
+    size_ += other.size_;
+    other.root_ = nullptr;
+    other.size_ = 0;
+    ShareBlocks(other);
+    other.AttachNulls();
+    if (bloom_hash_ && size_ > bloom_.capacity()) RebuildBloom();
+  }
+
+  // Erases [lo, hi), or everything from lo on if hi is null. An empty or
+  // inverted range splits off nothing and erases nothing.
+  template <class K>
+  size_type EraseBetween(const K &lo, const K *hi) {
+    size_type erased = 0;
+    if (root_) {
+      Node *lower = nullptr;
+      Node *middle = nullptr;
+      Node *upper = nullptr;
+      DetachNulls();
+      SplitNodes(root_, lo, lower, middle);
+      if (hi) SplitNodes(middle, *hi, middle, upper);
+      erased = DestroyNodes(middle);
+      S21_COUNT(tree_erases, erased);
+      root_ = ConcatNodes(lower, upper);
+      size_ -= erased;
+      AttachNulls();
+      BloomErased(erased);
+    }
+    return erased;
   }
 };
 
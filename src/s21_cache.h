@@ -0,0 +1,334 @@
+#ifndef CONTAINERS_SRC_S21_CACHE_H_
+#define CONTAINERS_SRC_S21_CACHE_H_
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_intrusive.h"
+#include "s21_vector.h"
+
+namespace s21 {
+namespace cache {
+// Open-addressing table from key hashes to pool slots, sized once for the
+// cache capacity at half load. Buckets keep the full hash so probing rarely
+// touches the pool and erase can shift buckets back without rehashing keys.
+template <class Key, class Hash>
+class Index {
+ public:
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  explicit Index(size_t capacity)
+      : buckets_(BucketCount(capacity)), mask_(buckets_.size() - 1) {}
+
+  // key_of(slot) gives the key stored in a pool slot.
+  template <class KeyOf>
+  uint32_t Find(const Key &key, KeyOf key_of) const {
+    uint32_t hash = HashOf(key);
+    for (size_t i = hash & mask_;; i = (i + 1) & mask_) {
+      const Bucket &bucket = buckets_[i];
+      if (bucket.slot_ == kNone) return kNone;
+      if (bucket.hash_ == hash && key_of(bucket.slot_) == key)
+        return bucket.slot_;
+    }
+  }
+
+  // key must not be in the index.
+  void Insert(const Key &key, uint32_t slot) {
+    uint32_t hash = HashOf(key);
+    size_t i = hash & mask_;
+    while (buckets_[i].slot_ != kNone) i = (i + 1) & mask_;
+    buckets_[i].hash_ = hash;
+    buckets_[i].slot_ = slot;
+  }
+
+  // Removes slot, which must be indexed under key, and closes the gap by
+  // moving back later buckets of the same probe run.
+  void Erase(const Key &key, uint32_t slot) {
+    size_t i = HashOf(key) & mask_;
+    while (buckets_[i].slot_ != slot) i = (i + 1) & mask_;
+    for (size_t j = (i + 1) & mask_; buckets_[j].slot_ != kNone;
+         j = (j + 1) & mask_) {
+      size_t home = buckets_[j].hash_ & mask_;
+      if (((j - home) & mask_) >= ((j - i) & mask_)) {
+        buckets_[i] = buckets_[j];
+        i = j;
+      }
+    }
+    buckets_[i].slot_ = kNone;
+  }
+
+  void Clear() {
+    for (size_t i = 0; i < buckets_.size(); ++i) buckets_[i].slot_ = kNone;
+  }
+
+ private:
+  struct Bucket {
+    uint32_t slot_ = kNone;
+    uint32_t hash_ = 0;
+  };
+
+  Vector<Bucket> buckets_;
+  size_t mask_;
+
+  static size_t BucketCount(size_t capacity) {
+    size_t buckets = 2;
+    while (buckets < capacity * 2) buckets *= 2;
+    return buckets;
+  }
+
+  // std::hash is the identity for integers; the multiply spreads patterned
+  // keys over the low bits used as the bucket index.
+  static uint32_t HashOf(const Key &key) {
+    return (uint32_t)(((uint64_t)Hash()(key) * 0x9e3779b97f4a7c15u) >> 32);
+  }
+};
+
+// State shared by the replacement policies: the slot pool, the index, free
+// slots, counters and the eviction callback. Every slot is allocated up
+// front, so get, put and erase never allocate.
+template <class Key, class T, class Hash, class Entry>
+class Base {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using size_type = size_t;
+  using evict_callback = std::function<void(const Key &, T &)>;
+
+  size_type size() const { return size_; }
+  size_type capacity() const { return pool_.size(); }
+  bool empty() const { return !size_; }
+
+  // Lookups through get() that found, or did not find, their key.
+  size_type hits() const { return hits_; }
+  size_type misses() const { return misses_; }
+
+  void reset_counters() { hits_ = misses_ = 0; }
+
+  // Does not count as a use.
+  bool contains(const Key &key) const { return Find(key) != kNone; }
+
+  // Called with each entry that put() pushes out, before it is overwritten.
+  // Not called for erase() or clear().
+  void on_evict(evict_callback callback) { on_evict_ = std::move(callback); }
+
+ protected:
+  static constexpr uint32_t kNone = Index<Key, Hash>::kNone;
+
+  Vector<Entry> pool_;
+  Index<Key, Hash> index_;
+  Vector<uint32_t> free_;
+  size_type size_ = 0;
+  size_type hits_ = 0;
+  size_type misses_ = 0;
+  evict_callback on_evict_;
+
+  explicit Base(size_type capacity)
+      : pool_(Checked(capacity)), index_(capacity) {
+    free_.reserve(capacity);
+    ResetFree();
+  }
+
+  uint32_t Find(const Key &key) const {
+    return index_.Find(key, [this](uint32_t slot) -> const Key & {
+      return pool_[slot].key_;
+    });
+  }
+
+  // A free slot, or kNone if the cache is full.
+  uint32_t TakeFree() {
+    if (free_.empty()) return kNone;
+    uint32_t slot = free_[free_.size() - 1];
+    free_.pop_back();
+    return slot;
+  }
+
+  void Fill(uint32_t slot, const Key &key, T &&value) {
+    pool_[slot].key_ = key;
+    pool_[slot].value_ = std::move(value);
+    index_.Insert(key, slot);
+    ++size_;
+  }
+
+  void Evict(uint32_t slot) {
+    Entry &entry = pool_[slot];
+    if (on_evict_) on_evict_(entry.key_, entry.value_);
+    index_.Erase(entry.key_, slot);
+    --size_;
+  }
+
+  void Release(uint32_t slot) {
+    index_.Erase(pool_[slot].key_, slot);
+    free_.push_back(slot);
+    --size_;
+  }
+
+  void ResetFree() {
+    free_.clear();
+    for (size_type i = pool_.size(); i > 0; --i) free_.push_back(i - 1);
+    index_.Clear();
+    size_ = 0;
+  }
+
+ private:
+  static size_type Checked(size_type capacity) {
+    if (!capacity || capacity >= kNone)
+      throw std::out_of_range("s21::cache: capacity out of range");
+    return capacity;
+  }
+};
+
+template <class Key, class T>
+struct LruEntry {
+  Key key_;
+  T value_;
+  ListHook recency_;
+};
+
+template <class Key, class T>
+struct ClockEntry {
+  Key key_;
+  T value_;
+  bool referenced_ = false;
+};
+}  // namespace cache
+
+// Fixed-capacity map that evicts the least recently used entry. Recency is
+// an IntrusiveList threaded through the pool, most recent at the front, so
+// a hit is one unlink and relink. Key and T must be default constructible.
+template <class Key, class T, class Hash = std::hash<Key>>
+class LruCache : public cache::Base<Key, T, Hash, cache::LruEntry<Key, T>> {
+  using Base = cache::Base<Key, T, Hash, cache::LruEntry<Key, T>>;
+  using Entry = cache::LruEntry<Key, T>;
+
+ public:
+  using typename Base::size_type;
+
+  explicit LruCache(size_type capacity) : Base(capacity) {}
+
+  LruCache(const LruCache &) = delete;
+  LruCache &operator=(const LruCache &) = delete;
+
+  // The cached value, made most recently used, or nullptr.
+  T *get(const Key &key) {
+    uint32_t slot = this->Find(key);
+    if (slot == Base::kNone) {
+      ++this->misses_;
+      return nullptr;
+    }
+    ++this->hits_;
+    Entry &entry = this->pool_[slot];
+    recency_.erase(entry);
+    recency_.push_front(entry);
+    return &entry.value_;
+  }
+
+  // Inserts or replaces the value for key and makes it most recently used.
+  void put(const Key &key, T value) {
+    uint32_t slot = this->Find(key);
+    if (slot != Base::kNone) {
+      Entry &entry = this->pool_[slot];
+      entry.value_ = std::move(value);
+      recency_.erase(entry);
+      recency_.push_front(entry);
+      return;
+    }
+    slot = this->TakeFree();
+    if (slot == Base::kNone) {
+      Entry &victim = recency_.back();
+      recency_.pop_back();
+      slot = (uint32_t)(&victim - this->pool_.data());
+      this->Evict(slot);
+    }
+    this->Fill(slot, key, std::move(value));
+    recency_.push_front(this->pool_[slot]);
+  }
+
+  bool erase(const Key &key) {
+    uint32_t slot = this->Find(key);
+    if (slot == Base::kNone) return false;
+    recency_.erase(this->pool_[slot]);
+    this->Release(slot);
+    return true;
+  }
+
+  void clear() {
+    recency_.clear();
+    this->ResetFree();
+  }
+
+ private:
+  IntrusiveList<Entry, &Entry::recency_> recency_;
+};
+
+// Fixed-capacity map with CLOCK replacement, an approximation of LRU: a hit
+// only sets a bit, and put() sweeps a hand over the pool, clearing bits,
+// until it finds an entry not used since the last sweep.
+template <class Key, class T, class Hash = std::hash<Key>>
+class ClockCache
+    : public cache::Base<Key, T, Hash, cache::ClockEntry<Key, T>> {
+  using Base = cache::Base<Key, T, Hash, cache::ClockEntry<Key, T>>;
+  using Entry = cache::ClockEntry<Key, T>;
+
+ public:
+  using typename Base::size_type;
+
+  explicit ClockCache(size_type capacity) : Base(capacity) {}
+
+  ClockCache(const ClockCache &) = delete;
+  ClockCache &operator=(const ClockCache &) = delete;
+
+  T *get(const Key &key) {
+    uint32_t slot = this->Find(key);
+    if (slot == Base::kNone) {
+      ++this->misses_;
+      return nullptr;
+    }
+    ++this->hits_;
+    this->pool_[slot].referenced_ = true;
+    return &this->pool_[slot].value_;
+  }
+
+  void put(const Key &key, T value) {
+    uint32_t slot = this->Find(key);
+    if (slot != Base::kNone) {
+      this->pool_[slot].value_ = std::move(value);
+      this->pool_[slot].referenced_ = true;
+      return;
+    }
+    slot = this->TakeFree();
+    if (slot == Base::kNone) {
+      slot = Sweep();
+      this->Evict(slot);
+    }
+    this->Fill(slot, key, std::move(value));
+    this->pool_[slot].referenced_ = false;
+  }
+
+  bool erase(const Key &key) {
+    uint32_t slot = this->Find(key);
+    if (slot == Base::kNone) return false;
+    this->Release(slot);
+    return true;
+  }
+
+  void clear() { this->ResetFree(); }
+
+ private:
+  size_type hand_ = 0;
+
+  // Only called when every slot is in use.
+  uint32_t Sweep() {
+    while (true) {
+      Entry &entry = this->pool_[hand_];
+      uint32_t slot = (uint32_t)hand_;
+      hand_ = hand_ + 1 == this->pool_.size() ? 0 : hand_ + 1;
+      if (!entry.referenced_) return slot;
+      entry.referenced_ = false;
+    }
+  }
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_CACHE_H_
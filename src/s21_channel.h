@@ -0,0 +1,389 @@
+#ifndef CONTAINERS_SRC_S21_CHANNEL_H_
+#define CONTAINERS_SRC_S21_CHANNEL_H_
+
+// Coroutine channels need C++20; in earlier modes this header is empty.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+#include "s21_queue.h"
+#include "s21_vector.h"
+
+namespace s21 {
+namespace coro {
+class Executor;
+
+// Fire-and-forget coroutine started by Executor::Spawn. The frame destroys
+// itself when the body returns.
+class Task {
+ public:
+  struct promise_type {
+    Executor *executor_ = nullptr;
+
+    Task get_return_object() {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept;
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+
+  Task(Task &&other) : handle_(std::exchange(other.handle_, nullptr)) {}
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+
+  ~Task() {
+    if (handle_) handle_.destroy();
+  }
+
+ private:
+  friend class Executor;
+  std::coroutine_handle<promise_type> handle_;
+
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+};
+
+// Runs coroutine handles. A coroutine suspended on a Channel is resumed
+// through the executor it was running on.
+class Executor {
+ public:
+  virtual ~Executor() {}
+
+  virtual void Post(std::coroutine_handle<> handle) = 0;
+
+  void Spawn(Task task) {
+    task.handle_.promise().executor_ = this;
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    Post(std::exchange(task.handle_, nullptr));
+  }
+
+  // Spawned tasks that have not finished yet.
+  size_t pending() const { return pending_.load(std::memory_order_acquire); }
+
+  // The executor running the calling thread's current coroutine, if any.
+  static Executor *&Current() {
+    thread_local Executor *current = nullptr;
+    return current;
+  }
+
+ protected:
+  void Resume(std::coroutine_handle<> handle) {
+    Executor *previous = Current();
+    Current() = this;
+    handle.resume();
+    Current() = previous;
+  }
+
+  virtual void Finished() { pending_.fetch_sub(1, std::memory_order_acq_rel); }
+
+ private:
+  friend struct Task::promise_type;
+  std::atomic<size_t> pending_{0};
+};
+
+inline std::suspend_never Task::promise_type::final_suspend() noexcept {
+  if (executor_) executor_->Finished();
+  return {};
+}
+
+// Runs everything on the thread that calls Run(). Post must only be called
+// from that thread.
+class SingleThreadExecutor : public Executor {
+ public:
+  void Post(std::coroutine_handle<> handle) override { ready_.push(handle); }
+
+  // Resumes coroutines until none is ready.
+  void Run() {
+    while (!ready_.empty()) {
+      std::coroutine_handle<> handle = ready_.front();
+      ready_.pop();
+      Resume(handle);
+    }
+  }
+
+ private:
+  Queue<std::coroutine_handle<>> ready_;
+};
+
+// A fixed set of worker threads sharing one ready queue.
+class ThreadPoolExecutor : public Executor {
+ public:
+  explicit ThreadPoolExecutor(size_t threads) {
+    for (size_t i = 0; i < threads; ++i)
+      workers_.push_back(new std::thread([this] { Work(); }));
+  }
+
+  ThreadPoolExecutor(const ThreadPoolExecutor &) = delete;
+  ThreadPoolExecutor &operator=(const ThreadPoolExecutor &) = delete;
+
+  // Coroutines still suspended at this point are never resumed.
+  ~ThreadPoolExecutor() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    ready_changed_.notify_all();
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      workers_[i]->join();
+      delete workers_[i];
+    }
+  }
+
+  void Post(std::coroutine_handle<> handle) override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ready_.push(handle);
+    }
+    ready_changed_.notify_one();
+  }
+
+  // Blocks until every spawned task has finished.
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_.wait(lock, [this] { return !pending(); });
+  }
+
+ protected:
+  void Finished() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Executor::Finished();
+    if (!pending()) finished_.notify_all();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable ready_changed_;
+  std::condition_variable finished_;
+  Queue<std::coroutine_handle<>> ready_;
+  Vector<std::thread *> workers_;
+  bool stopping_ = false;
+
+  void Work() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      ready_changed_.wait(lock,
+                          [this] { return stopping_ || !ready_.empty(); });
+      if (stopping_) return;
+      std::coroutine_handle<> handle = ready_.front();
+      ready_.pop();
+      lock.unlock();
+      Resume(handle);
+      lock.lock();
+    }
+  }
+};
+}  // namespace coro
+
+// Bounded FIFO between coroutines: co_await send(v) suspends while the ring
+// is full and co_await receive() while it is empty, without blocking the
+// thread. A waiting receiver gets a value straight from the sender. With
+// capacity 0 every send waits for a receiver. Safe to use from coroutines on
+// different threads.
+template <typename T>
+class Channel {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+
+ private:
+  struct Waiter {
+    std::coroutine_handle<> handle_;
+    coro::Executor *executor_ = nullptr;
+    Waiter *next_ = nullptr;
+
+    void Suspend(std::coroutine_handle<> handle) {
+      handle_ = handle;
+      executor_ = coro::Executor::Current();
+    }
+
+    // The waiter may be destroyed as soon as its coroutine resumes.
+    void Wake() {
+      if (executor_)
+        executor_->Post(handle_);
+      else
+        handle_.resume();
+    }
+  };
+
+  template <class W>
+  struct WaitList {
+    Waiter *head_ = nullptr;
+    Waiter *tail_ = nullptr;
+
+    void Push(W *waiter) {
+      if (tail_)
+        tail_->next_ = waiter;
+      else
+        head_ = waiter;
+      tail_ = waiter;
+    }
+
+    W *Pop() {
+      Waiter *waiter = head_;
+      if (waiter) {
+        head_ = waiter->next_;
+        if (!head_) tail_ = nullptr;
+      }
+      return static_cast<W *>(waiter);
+    }
+
+    W *TakeAll() {
+      Waiter *all = head_;
+      head_ = tail_ = nullptr;
+      return static_cast<W *>(all);
+    }
+  };
+
+ public:
+  // co_await yields false if the channel was closed and value not sent.
+  class SendAwaiter : public Waiter {
+   public:
+    bool await_ready() const { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+      std::unique_lock<std::mutex> lock(channel_->mutex_);
+      if (channel_->closed_) {
+        sent_ = false;
+        return false;
+      }
+      if (ReceiveAwaiter *receiver = channel_->receivers_.Pop()) {
+        receiver->value_.emplace(std::move(value_));
+        lock.unlock();
+        receiver->Wake();
+        return false;
+      }
+      if (channel_->count_ < channel_->ring_.size()) {
+        channel_->Enqueue(std::move(value_));
+        return false;
+      }
+      this->Suspend(handle);
+      channel_->senders_.Push(this);
+      return true;
+    }
+
+    bool await_resume() const { return sent_; }
+
+   private:
+    friend class Channel;
+    Channel *channel_;
+    T value_;
+    bool sent_ = true;
+
+    SendAwaiter(Channel *channel, T &&value)
+        : channel_(channel), value_(std::move(value)) {}
+  };
+
+  // co_await yields the next value, or nullopt once the channel is closed
+  // and drained.
+  class ReceiveAwaiter : public Waiter {
+   public:
+    bool await_ready() const { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+      std::unique_lock<std::mutex> lock(channel_->mutex_);
+      SendAwaiter *sender = channel_->senders_.Pop();
+      if (channel_->count_) {
+        value_.emplace(channel_->Dequeue());
+        if (sender) channel_->Enqueue(std::move(sender->value_));
+      } else if (sender) {
+        value_.emplace(std::move(sender->value_));
+      } else if (!channel_->closed_) {
+        this->Suspend(handle);
+        channel_->receivers_.Push(this);
+        return true;
+      }
+      lock.unlock();
+      if (sender) sender->Wake();
+      return false;
+    }
+
+    std::optional<T> await_resume() { return std::move(value_); }
+
+   private:
+    friend class Channel;
+    Channel *channel_;
+    std::optional<T> value_;
+
+    explicit ReceiveAwaiter(Channel *channel) : channel_(channel) {}
+  };
+
+  explicit Channel(size_type capacity) : ring_(capacity) {}
+
+  Channel(const Channel &) = delete;
+  Channel &operator=(const Channel &) = delete;
+
+  SendAwaiter send(T value) { return SendAwaiter(this, std::move(value)); }
+  ReceiveAwaiter receive() { return ReceiveAwaiter(this); }
+
+  // Fails every waiting sender and wakes every waiting receiver with
+  // nullopt. Values already in the ring can still be received.
+  void close() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    closed_ = true;
+    SendAwaiter *senders = senders_.TakeAll();
+    ReceiveAwaiter *receivers = receivers_.TakeAll();
+    for (SendAwaiter *sender = senders; sender;
+         sender = static_cast<SendAwaiter *>(sender->next_))
+      sender->sent_ = false;
+    lock.unlock();
+    WakeAll(senders);
+    WakeAll(receivers);
+  }
+
+  bool closed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+  }
+
+  size_type size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return count_;
+  }
+
+  size_type capacity() const { return ring_.size(); }
+
+ private:
+  mutable std::mutex mutex_;
+  Vector<T> ring_;
+  size_type head_ = 0;
+  size_type count_ = 0;
+  bool closed_ = false;
+  WaitList<SendAwaiter> senders_;
+  WaitList<ReceiveAwaiter> receivers_;
+
+  void Enqueue(T &&value) {
+    size_type tail = head_ + count_;
+    if (tail >= ring_.size()) tail -= ring_.size();
+    ring_[tail] = std::move(value);
+    ++count_;
+  }
+
+  T Dequeue() {
+    T value = std::move(ring_[head_]);
+    head_ = head_ + 1 == ring_.size() ? 0 : head_ + 1;
+    --count_;
+    return value;
+  }
+
+  template <class W>
+  static void WakeAll(W *waiter) {
+    while (waiter) {
+      W *next = static_cast<W *>(waiter->next_);
+      waiter->Wake();
+      waiter = next;
+    }
+  }
+};
+}  // namespace s21
+
+#endif  // __cpp_impl_coroutine
+
+#endif  // CONTAINERS_SRC_S21_CHANNEL_H_
@@ -0,0 +1,354 @@
+#ifndef CONTAINERS_SRC_S21_COMPACT_BTREE_H_
+#define CONTAINERS_SRC_S21_COMPACT_BTREE_H_
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_comparators.h"
+#include "s21_vector.h"
+
+namespace s21 {
+// Node layouts selectable through the last template parameter of Set and
+// Map. PointerNodes allocates every node separately and links them with
+// pointers; CompactNodes keeps them in one pool linked by 32-bit indices.
+struct PointerNodes {};
+struct CompactNodes {};
+
+// The same unbalanced search tree as BTree, but with 12 bytes of links per
+// node instead of 24 and no per-node allocation. Erased slots are reused
+// through a free list threaded through right_. Iterators hold an index, so
+// they survive the pool growing. Capacity is limited to 2^32 - 1 nodes.
+template <class Key, class Compare = SingleComparator<Key>>
+class CompactBTree {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using reference = key_type &;
+  using const_reference = const key_type &;
+  using size_type = size_t;
+  using index_type = uint32_t;
+
+  static constexpr index_type kNull = std::numeric_limits<index_type>::max();
+
+  struct Node {
+    index_type parent_ = kNull;
+    index_type left_ = kNull;
+    index_type right_ = kNull;
+    value_type data_;
+  };
+
+  class ConstIterator;
+
+  class Iterator {
+   public:
+    Iterator() : tree_(nullptr), index_(kNull) {}
+    Iterator(CompactBTree *tree, index_type index)
+        : tree_(tree), index_(index) {}
+
+    index_type index() const { return index_; }
+
+    value_type &operator*() const { return tree_->pool_[index_].data_; }
+
+    Iterator &operator++() {
+      index_ = tree_->Next(index_);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    Iterator &operator--() {
+      index_ = tree_->Prev(index_);
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    Iterator operator+(int n) const {
+      Iterator tmp = *this;
+      for (int i = 0; i < n; ++i) ++tmp;
+      return tmp;
+    }
+
+    Iterator operator-(int n) const {
+      Iterator tmp = *this;
+      for (int i = 0; i < n; ++i) --tmp;
+      return tmp;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return index_ == other.index_ && tree_ == other.tree_;
+    }
+
+    bool operator!=(const Iterator &other) const { return !(*this == other); }
+
+   protected:
+    friend class ConstIterator;
+
+    CompactBTree *tree_;
+    index_type index_;
+  };
+
+  // Not derived from Iterator, so it can neither write through operator*
+  // nor be turned back into an Iterator.
+  class ConstIterator {
+   public:
+    ConstIterator() : tree_(nullptr), index_(kNull) {}
+    ConstIterator(const CompactBTree *tree, index_type index)
+        : tree_(tree), index_(index) {}
+    ConstIterator(const Iterator &other)
+        : tree_(other.tree_), index_(other.index_) {}
+
+    index_type index() const { return index_; }
+
+    const value_type &operator*() const { return tree_->pool_[index_].data_; }
+
+    ConstIterator &operator++() {
+      index_ = tree_->Next(index_);
+      return *this;
+    }
+
+    ConstIterator operator++(int) {
+      ConstIterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    ConstIterator &operator--() {
+      index_ = tree_->Prev(index_);
+      return *this;
+    }
+
+    ConstIterator operator--(int) {
+      ConstIterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    ConstIterator operator+(int n) const {
+      ConstIterator tmp = *this;
+      for (int i = 0; i < n; ++i) ++tmp;
+      return tmp;
+    }
+
+    ConstIterator operator-(int n) const {
+      ConstIterator tmp = *this;
+      for (int i = 0; i < n; ++i) --tmp;
+      return tmp;
+    }
+
+    bool operator==(const ConstIterator &other) const {
+      return index_ == other.index_ && tree_ == other.tree_;
+    }
+
+    bool operator!=(const ConstIterator &other) const {
+      return !(*this == other);
+    }
+
+   private:
+    const CompactBTree *tree_;
+    index_type index_;
+  };
+
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  iterator begin() { return iterator(this, min_); }
+  iterator end() { return iterator(this, kNull); }
+  const_iterator cbegin() const { return const_iterator(this, min_); }
+  const_iterator cend() const { return const_iterator(this, kNull); }
+
+  bool empty() const { return !size_; }
+  size_type size() const { return size_; }
+
+  // Bounded by the 32-bit indices and by what the pool can hold.
+  size_type max_size() const {
+    return pool_.max_size() < kNull - 1 ? pool_.max_size() : kNull - 1;
+  }
+
+  // Bytes held by the node pool, including free and reserved slots.
+  size_type memory_usage() const { return pool_.capacity() * sizeof(Node); }
+
+  void clear() {
+    pool_.clear();
+    root_ = min_ = max_ = free_ = kNull;
+    size_ = 0;
+  }
+
+  void erase(iterator pos) {
+    if (pos.index() != kNull) EraseIndex(pos.index());
+  }
+
+  void swap(CompactBTree &other) {
+    pool_.swap(other.pool_);
+    std::swap(root_, other.root_);
+    std::swap(min_, other.min_);
+    std::swap(max_, other.max_);
+    std::swap(free_, other.free_);
+    std::swap(size_, other.size_);
+  }
+
+ protected:
+  Vector<Node> pool_;
+  index_type root_ = kNull;
+  index_type min_ = kNull;
+  index_type max_ = kNull;
+  index_type free_ = kNull;
+  size_type size_ = 0;
+  key_compare comparator_;
+
+  index_type Search(const key_type &key) const {
+    index_type node = root_;
+    while (node != kNull) {
+      const value_type &data = pool_[node].data_;
+      if (comparator_.LessThan(key, data))
+        node = pool_[node].left_;
+      else if (comparator_.GreaterThan(key, data))
+        node = pool_[node].right_;
+      else
+        break;
+    }
+    return node;
+  }
+
+  std::pair<iterator, bool> InsertOrPaste(const key_type &key) {
+    index_type parent = kNull;
+    bool left = false;
+    if (root_ != kNull) {
+      if (comparator_.GreaterThan(key, pool_[max_].data_)) {
+        parent = max_;
+      } else {
+        index_type node = root_;
+        while (node != kNull) {
+          parent = node;
+          if (comparator_.LessThan(key, pool_[node].data_)) {
+            node = pool_[node].left_;
+            left = true;
+          } else if (comparator_.GreaterThan(key, pool_[node].data_)) {
+            node = pool_[node].right_;
+            left = false;
+          } else {
+            return std::pair<iterator, bool>(iterator(this, node), false);
+          }
+        }
+      }
+    }
+    index_type node = Allocate(key);
+    pool_[node].parent_ = parent;
+    if (parent == kNull) {
+      root_ = min_ = max_ = node;
+    } else if (left) {
+      pool_[parent].left_ = node;
+      if (parent == min_) min_ = node;
+    } else {
+      pool_[parent].right_ = node;
+      if (parent == max_) max_ = node;
+    }
+    ++size_;
+    return std::pair<iterator, bool>(iterator(this, node), true);
+  }
+
+  void EraseIndex(index_type node) {
+    if (node == min_) min_ = Next(node);
+    if (node == max_) max_ = Prev(node);
+    index_type left = pool_[node].left_;
+    index_type right = pool_[node].right_;
+    if (left == kNull) {
+      Transplant(node, right);
+    } else if (right == kNull) {
+      Transplant(node, left);
+    } else {
+      index_type successor = Leftmost(right);
+      if (pool_[successor].parent_ != node) {
+        Transplant(successor, pool_[successor].right_);
+        pool_[successor].right_ = right;
+        pool_[right].parent_ = successor;
+      }
+      Transplant(node, successor);
+      pool_[successor].left_ = left;
+      pool_[left].parent_ = successor;
+    }
+    Release(node);
+    --size_;
+  }
+
+  index_type Next(index_type node) const {
+    if (pool_[node].right_ != kNull) return Leftmost(pool_[node].right_);
+    index_type parent = pool_[node].parent_;
+    while (parent != kNull && pool_[parent].right_ == node) {
+      node = parent;
+      parent = pool_[node].parent_;
+    }
+    return parent;
+  }
+
+  // Prev(kNull) is the maximum, so --end() works.
+  index_type Prev(index_type node) const {
+    if (node == kNull) return max_;
+    if (pool_[node].left_ != kNull) return Rightmost(pool_[node].left_);
+    index_type parent = pool_[node].parent_;
+    while (parent != kNull && pool_[parent].left_ == node) {
+      node = parent;
+      parent = pool_[node].parent_;
+    }
+    return parent;
+  }
+
+ private:
+  index_type Leftmost(index_type node) const {
+    while (pool_[node].left_ != kNull) node = pool_[node].left_;
+    return node;
+  }
+
+  index_type Rightmost(index_type node) const {
+    while (pool_[node].right_ != kNull) node = pool_[node].right_;
+    return node;
+  }
+
+  void Transplant(index_type old_node, index_type new_node) {
+    index_type parent = pool_[old_node].parent_;
+    if (parent == kNull)
+      root_ = new_node;
+    else if (pool_[parent].left_ == old_node)
+      pool_[parent].left_ = new_node;
+    else
+      pool_[parent].right_ = new_node;
+    if (new_node != kNull) pool_[new_node].parent_ = parent;
+  }
+
+  index_type Allocate(const key_type &key) {
+    index_type node = free_;
+    if (node != kNull) {
+      free_ = pool_[node].right_;
+      pool_[node] = Node();
+      pool_[node].data_ = key;
+    } else {
+      if (pool_.size() >= max_size())
+        throw std::length_error("s21::CompactBTree: too many nodes");
+      Node fresh;
+      fresh.data_ = key;
+      pool_.push_back(fresh);
+      node = (index_type)(pool_.size() - 1);
+    }
+    return node;
+  }
+
+  void Release(index_type node) {
+    pool_[node].data_ = value_type();
+    pool_[node].right_ = free_;
+    free_ = node;
+  }
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_COMPACT_BTREE_H_
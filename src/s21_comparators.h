@@ -1,13 +1,47 @@
 #ifndef CONTAINERS_SRC_S21_COMPARATORS_H_
 #define CONTAINERS_SRC_S21_COMPARATORS_H_
 
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 
 namespace s21 {
+// Whether a lookup may compare a K against a Key as it is, without
+// converting it first: a Key itself, or text such as a std::string_view or
+// a string literal for std::basic_string keys. Other probes are converted
+// to Key at the call, as they would be without heterogeneous lookup, so
+// Set<unsigned>::contains(3) and Set<int>::contains(1.5) keep their
+// meaning.
+template <class Key, class K>
+struct IsKeyProbe : std::is_same<Key, K> {};
+
+template <class C, class T, class A, class K>
+struct IsKeyProbe<std::basic_string<C, T, A>, K>
+    : std::bool_constant<
+          std::is_same<std::basic_string<C, T, A>, K>::value ||
+          std::is_convertible<const K &, std::basic_string_view<C, T>>::value> {
+};
+
+template <class Key, class K>
+using EnableIfKeyProbe = std::enable_if_t<IsKeyProbe<Key, K>::value>;
+
+// Both comparators are transparent for the probes IsKeyProbe accepts:
+// lookups in Set and Map may pass a std::string_view for std::string keys
+// without building a std::string first.
 template <class A>
 struct SingleComparator {
   using type = A;
+  using is_transparent = void;
   bool LessThan(const type &a, const type &b) const { return a < b; }
+  template <class K, class = EnableIfKeyProbe<A, K>>
+  bool LessThan(const type &a, const K &b) const {
+    return a < b;
+  }
+  template <class K, class = EnableIfKeyProbe<A, K>>
+  bool LessThan(const K &a, const type &b) const {
+    return a < b;
+  }
   bool GreaterThan(const type &a, const type &b) const { return a > b; }
   bool LessOrEquals(const type &a, const type &b) const { return a <= b; }
   bool GreaterOrEquals(const type &a, const type &b) const { return a >= b; }
@@ -18,9 +52,18 @@ struct SingleComparator {
 template <class A, class B>
 struct PairComparator {
   using pair = std::pair<A, B>;
+  using is_transparent = void;
   bool LessThan(const pair &a, const pair &b) const {
     return a.first < b.first;
   }
+  template <class K, class = EnableIfKeyProbe<A, K>>
+  bool LessThan(const pair &a, const K &b) const {
+    return a.first < b;
+  }
+  template <class K, class = EnableIfKeyProbe<A, K>>
+  bool LessThan(const K &a, const pair &b) const {
+    return a < b.first;
+  }
   bool GreaterThan(const pair &a, const pair &b) const {
     return a.first > b.first;
   }
@@ -36,6 +79,50 @@ struct PairComparator {
   }
 };
 
+template <class C, class = void>
+struct IsTransparent : std::false_type {};
+
+template <class C>
+struct IsTransparent<C, std::void_t<typename C::is_transparent>>
+    : std::true_type {};
+
+// True for the default comparator of a container of V. These order keys by
+// operator<, so keys they treat as equal also hash alike with std::hash.
+template <class V, class Compare>
+struct IsDefaultComparator : std::is_same<Compare, SingleComparator<V>> {};
+
+template <class A, class B, class Compare>
+struct IsDefaultComparator<std::pair<A, B>, Compare>
+    : std::bool_constant<
+          std::is_same<Compare, SingleComparator<std::pair<A, B>>>::value ||
+          std::is_same<Compare, PairComparator<A, B>>::value> {};
+
+// Orders bare keys the way Compare orders the Map pairs holding them, for
+// FrozenMap and MappedMap, which keep keys apart from values. Each key is
+// wrapped in a pair with a default T, so T must be default constructible.
+template <class Key, class T, class Compare>
+struct PairKeyComparator {
+  using pair = std::pair<Key, T>;
+  Compare pairs_;
+  bool LessThan(const Key &a, const Key &b) const {
+    return pairs_.LessThan(pair(a, T()), pair(b, T()));
+  }
+};
+
+// The key comparator for a Map ordered by Compare. The default
+// PairComparator compares only the keys, so it needs no wrapping.
+template <class Key, class T, class Compare>
+struct KeyComparatorFor {
+  using type = PairKeyComparator<Key, T, Compare>;
+};
+
+template <class Key, class T>
+struct KeyComparatorFor<Key, T, PairComparator<Key, T>> {
+  using type = SingleComparator<Key>;
+};
+
+template <class Key, class T, class Compare>
+using KeyComparator = typename KeyComparatorFor<Key, T, Compare>::type;
 }  // namespace s21
 
 #endif  // CONTAINERS_SRC_S21_COMPARATORS_H_
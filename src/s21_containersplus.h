@@ -0,0 +1,22 @@
+#ifndef CONTAINERS_SRC_S21_CONTAINERSPLUS_H_
+#define CONTAINERS_SRC_S21_CONTAINERSPLUS_H_
+
+#include "s21_algorithm.h"
+#include "s21_blocking_queue.h"
+#include "s21_bloom.h"
+#include "s21_cache.h"
+#include "s21_channel.h"
+#include "s21_intrusive.h"
+#include "s21_lock_free_stack.h"
+#include "s21_mapped.h"
+#include "s21_multimap.h"
+#include "s21_multiset.h"
+#include "s21_persistent_map.h"
+#include "s21_priority_queue.h"
+#include "s21_simd.h"
+#include "s21_smallvector.h"
+#include "s21_thread_pool.h"
+#include "s21_unrolled_list.h"
+#include "s21_work_stealing_deque.h"
+
+#endif  // CONTAINERS_SRC_S21_CONTAINERSPLUS_H_
@@ -0,0 +1,278 @@
+#ifndef CONTAINERS_SRC_S21_FROZEN_H_
+#define CONTAINERS_SRC_S21_FROZEN_H_
+
+#include <stdexcept>
+#include <utility>
+
+#include "s21_comparators.h"
+#include "s21_vector.h"
+
+namespace s21 {
+// Sorted keys in Eytzinger (breadth-first) order: the children of slot k are
+// 2k and 2k + 1, and slot 0 is unused. The top of the implicit tree stays in
+// cache, and a search prefetches the cache line holding its descendants a few
+// levels ahead instead of chasing pointers.
+template <class Key, class Compare = SingleComparator<Key>>
+class EytzingerIndex {
+ public:
+  using key_type = Key;
+  using size_type = size_t;
+
+  bool empty() const { return !size_; }
+  size_type size() const { return size_; }
+
+ protected:
+  Vector<key_type> keys_;
+  size_type size_ = 0;
+  Compare comparator_;
+
+  EytzingerIndex() : keys_(1) {}
+
+  // Visits the slots in key order, handing each to fn(k, it) together with
+  // the next element of a sorted sequence of n elements.
+  template <class InputIt, class F>
+  InputIt Build(InputIt first, size_type n, F fn) {
+    Vector<key_type> keys(n + 1);
+    keys_.swap(keys);
+    size_ = n;
+    return Fill(first, 1, fn);
+  }
+
+  // Slot of the first key not less than key, or 0 if there is none.
+  size_type LowerBound(const key_type &key) const {
+    const key_type *keys = keys_.data();
+    size_type k = 1;
+    while (k <= size_) {
+      if (k * kPrefetchStride <= size_)
+        __builtin_prefetch(keys + k * kPrefetchStride);
+      k = 2 * k + comparator_.LessThan(keys[k], key);
+    }
+    return k >> __builtin_ffsll((long long)~k);
+  }
+
+  size_type Find(const key_type &key) const {
+    size_type k = LowerBound(key);
+    return k && !comparator_.LessThan(key, keys_[k]) ? k : 0;
+  }
+
+  size_type First() const {
+    size_type k = size_ ? 1 : 0;
+    while (k && 2 * k <= size_) k = 2 * k;
+    return k;
+  }
+
+  size_type Next(size_type k) const {
+    if (2 * k + 1 <= size_) {
+      k = 2 * k + 1;
+      while (2 * k <= size_) k = 2 * k;
+      return k;
+    }
+    while (k & 1) k >>= 1;
+    return k >> 1;
+  }
+
+  // Prev(0) is the last slot, so --end() works.
+  size_type Prev(size_type k) const {
+    if (!k) {
+      k = size_ ? 1 : 0;
+      while (k && 2 * k + 1 <= size_) k = 2 * k + 1;
+      return k;
+    }
+    if (2 * k <= size_) {
+      k = 2 * k;
+      while (2 * k + 1 <= size_) k = 2 * k + 1;
+      return k;
+    }
+    while (k > 1 && !(k & 1)) k >>= 1;
+    return k >> 1;
+  }
+
+ private:
+  // Slots per cache line: prefetching k * kPrefetchStride loads all the
+  // descendants of k that many levels down at once.
+  static constexpr size_type kPrefetchStride =
+      sizeof(key_type) >= 64 ? 1 : 64 / sizeof(key_type);
+
+  template <class InputIt, class F>
+  InputIt Fill(InputIt it, size_type k, F &fn) {
+    if (k <= size_) {
+      it = Fill(it, 2 * k, fn);
+      fn(k, it);
+      ++it;
+      it = Fill(it, 2 * k + 1, fn);
+    }
+    return it;
+  }
+};
+
+// Immutable sorted set produced by Set::freeze().
+template <class Key, class Compare = SingleComparator<Key>>
+class FrozenSet : public EytzingerIndex<Key, Compare> {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using const_reference = const Key &;
+  using size_type = size_t;
+
+  class ConstIterator {
+   public:
+    ConstIterator() : set_(nullptr), slot_(0) {}
+    ConstIterator(const FrozenSet *set, size_type slot)
+        : set_(set), slot_(slot) {}
+
+    const_reference operator*() const { return set_->keys_[slot_]; }
+
+    ConstIterator &operator++() {
+      slot_ = set_->Next(slot_);
+      return *this;
+    }
+
+    ConstIterator operator++(int) {
+      ConstIterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    ConstIterator &operator--() {
+      slot_ = set_->Prev(slot_);
+      return *this;
+    }
+
+    ConstIterator operator--(int) {
+      ConstIterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    bool operator==(const ConstIterator &other) const {
+      return slot_ == other.slot_ && set_ == other.set_;
+    }
+
+    bool operator!=(const ConstIterator &other) const {
+      return !(*this == other);
+    }
+
+   private:
+    const FrozenSet *set_;
+    size_type slot_;
+  };
+
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+
+  FrozenSet() {}
+
+  template <class InputIt>
+  FrozenSet(InputIt sorted, size_type n) {
+    this->Build(sorted, n,
+                [this](size_type k, InputIt it) { this->keys_[k] = *it; });
+  }
+
+  const_iterator begin() const { return const_iterator(this, this->First()); }
+  const_iterator end() const { return const_iterator(this, 0); }
+
+  const_iterator find(const Key &key) const {
+    return const_iterator(this, this->Find(key));
+  }
+
+  bool contains(const Key &key) const { return this->Find(key) != 0; }
+
+  const_iterator lower_bound(const Key &key) const {
+    return const_iterator(this, this->LowerBound(key));
+  }
+};
+
+// Immutable sorted map produced by Map::freeze(). Keys are kept in their own
+// array so a search touches only keys; values sit in a parallel array.
+template <class Key, class T, class Compare = SingleComparator<Key>>
+class FrozenMap : public EytzingerIndex<Key, Compare> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key &, const T &>;
+  using size_type = size_t;
+
+  class ConstIterator {
+   public:
+    ConstIterator() : map_(nullptr), slot_(0) {}
+    ConstIterator(const FrozenMap *map, size_type slot)
+        : map_(map), slot_(slot) {}
+
+    const Key &key() const { return map_->keys_[slot_]; }
+    const T &value() const { return map_->values_[slot_]; }
+    value_type operator*() const { return value_type(key(), value()); }
+
+    ConstIterator &operator++() {
+      slot_ = map_->Next(slot_);
+      return *this;
+    }
+
+    ConstIterator operator++(int) {
+      ConstIterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    ConstIterator &operator--() {
+      slot_ = map_->Prev(slot_);
+      return *this;
+    }
+
+    ConstIterator operator--(int) {
+      ConstIterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    bool operator==(const ConstIterator &other) const {
+      return slot_ == other.slot_ && map_ == other.map_;
+    }
+
+    bool operator!=(const ConstIterator &other) const {
+      return !(*this == other);
+    }
+
+   private:
+    const FrozenMap *map_;
+    size_type slot_;
+  };
+
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+
+  FrozenMap() : values_(1) {}
+
+  // sorted yields std::pair<Key, T> in key order.
+  template <class InputIt>
+  FrozenMap(InputIt sorted, size_type n) : values_(n + 1) {
+    this->Build(sorted, n, [this](size_type k, InputIt it) {
+      this->keys_[k] = (*it).first;
+      values_[k] = (*it).second;
+    });
+  }
+
+  const_iterator begin() const { return const_iterator(this, this->First()); }
+  const_iterator end() const { return const_iterator(this, 0); }
+
+  const_iterator find(const Key &key) const {
+    return const_iterator(this, this->Find(key));
+  }
+
+  bool contains(const Key &key) const { return this->Find(key) != 0; }
+
+  const_iterator lower_bound(const Key &key) const {
+    return const_iterator(this, this->LowerBound(key));
+  }
+
+  const T &at(const Key &key) const {
+    size_type k = this->Find(key);
+    if (!k) throw std::out_of_range("s21::FrozenMap::at");
+    return values_[k];
+  }
+
+ private:
+  Vector<T> values_;
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_FROZEN_H_
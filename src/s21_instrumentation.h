@@ -0,0 +1,181 @@
+#ifndef CONTAINERS_SRC_S21_INSTRUMENTATION_H_
+#define CONTAINERS_SRC_S21_INSTRUMENTATION_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// Hot-path counters are compiled in only when S21_CONTAINERS_INSTRUMENTATION
+// is defined before the first container header is included; otherwise
+// S21_COUNT and S21_COUNT_MAX expand to nothing. The query functions below
+// are always available and report zeros in an uninstrumented build.
+#ifdef S21_CONTAINERS_INSTRUMENTATION
+#define S21_COUNT(counter, n) \
+  ::s21::instrumentation::Add(::s21::instrumentation::counter, (n))
+#define S21_COUNT_MAX(counter, n) \
+  ::s21::instrumentation::Max(::s21::instrumentation::counter, (n))
+#else
+#define S21_COUNT(counter, n) ((void)sizeof(n))
+#define S21_COUNT_MAX(counter, n) ((void)sizeof(n))
+#endif
+
+#define S21_INSTRUMENTATION_COUNTERS(X) \
+  X(tree_searches)                      \
+  X(tree_search_steps)                  \
+  X(tree_max_search_depth)              \
+  X(tree_inserts)                       \
+  X(tree_erases)                        \
+  X(tree_node_allocations)              \
+  X(tree_node_frees)                    \
+  X(vector_growths)                     \
+  X(vector_bytes_allocated)             \
+  X(list_inserts)                       \
+  X(list_erases)
+
+namespace s21 {
+namespace instrumentation {
+enum Counter : size_t {
+#define S21_COUNTER_ENUM(name) name,
+  S21_INSTRUMENTATION_COUNTERS(S21_COUNTER_ENUM)
+#undef S21_COUNTER_ENUM
+      kCounterCount
+};
+
+inline const char *Name(Counter counter) {
+  static const char *const kNames[] = {
+#define S21_COUNTER_NAME(name) #name,
+      S21_INSTRUMENTATION_COUNTERS(S21_COUNTER_NAME)
+#undef S21_COUNTER_NAME
+  };
+  return kNames[counter];
+}
+
+// Counters that record a high-water mark rather than a running total.
+inline bool IsMax(Counter counter) { return counter == tree_max_search_depth; }
+
+struct Counters {
+  uint64_t values[kCounterCount] = {};
+
+  uint64_t operator[](Counter counter) const { return values[counter]; }
+
+  void Merge(const Counters &other) {
+    for (size_t i = 0; i < kCounterCount; ++i) {
+      if (IsMax(Counter(i)))
+        values[i] = values[i] > other.values[i] ? values[i] : other.values[i];
+      else
+        values[i] += other.values[i];
+    }
+  }
+
+  std::string ToJson() const {
+    std::string json = "{";
+    for (size_t i = 0; i < kCounterCount; ++i) {
+      if (i) json += ", ";
+      json += '"';
+      json += Name(Counter(i));
+      json += "\": ";
+      json += std::to_string(values[i]);
+    }
+    return json + "}";
+  }
+};
+
+class Registry;
+
+// One per thread. Only the owning thread writes, so a relaxed load and store
+// replace a locked read-modify-write; other threads may read at any time.
+struct Slot {
+  std::atomic<uint64_t> values[kCounterCount] = {};
+  Slot *prev = nullptr;
+  Slot *next = nullptr;
+
+  Slot();
+  ~Slot();
+
+  Counters Load() const {
+    Counters counters;
+    for (size_t i = 0; i < kCounterCount; ++i)
+      counters.values[i] = values[i].load(std::memory_order_relaxed);
+    return counters;
+  }
+};
+
+// Process-wide list of live slots. Slots of finished threads are folded into
+// retired_ so their counts are not lost.
+class Registry {
+ public:
+  static Registry &Instance() {
+    static Registry registry;
+    return registry;
+  }
+
+  void Attach(Slot *slot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slot->next = head_;
+    if (head_) head_->prev = slot;
+    head_ = slot;
+  }
+
+  void Detach(Slot *slot) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired_.Merge(slot->Load());
+    if (slot->prev) slot->prev->next = slot->next;
+    if (slot->next) slot->next->prev = slot->prev;
+    if (head_ == slot) head_ = slot->next;
+  }
+
+  Counters Snapshot() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Counters total = retired_;
+    for (Slot *slot = head_; slot; slot = slot->next) total.Merge(slot->Load());
+    return total;
+  }
+
+  void Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired_ = Counters();
+    for (Slot *slot = head_; slot; slot = slot->next)
+      for (auto &value : slot->values)
+        value.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  std::mutex mutex_;
+  Slot *head_ = nullptr;
+  Counters retired_;
+};
+
+inline Slot::Slot() { Registry::Instance().Attach(this); }
+inline Slot::~Slot() { Registry::Instance().Detach(this); }
+
+inline Slot &LocalSlot() {
+  thread_local Slot slot;
+  return slot;
+}
+
+inline void Add(Counter counter, uint64_t n) {
+  std::atomic<uint64_t> &value = LocalSlot().values[counter];
+  value.store(value.load(std::memory_order_relaxed) + n,
+              std::memory_order_relaxed);
+}
+
+inline void Max(Counter counter, uint64_t n) {
+  std::atomic<uint64_t> &value = LocalSlot().values[counter];
+  if (n > value.load(std::memory_order_relaxed))
+    value.store(n, std::memory_order_relaxed);
+}
+
+// Counters of the calling thread only.
+inline Counters ThreadCounters() { return LocalSlot().Load(); }
+
+// Counters summed over every thread, including threads that have exited.
+inline Counters Snapshot() { return Registry::Instance().Snapshot(); }
+
+inline void Reset() { Registry::Instance().Reset(); }
+
+inline std::string DumpJson() { return Snapshot().ToJson(); }
+}  // namespace instrumentation
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_INSTRUMENTATION_H_
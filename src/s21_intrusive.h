@@ -0,0 +1,425 @@
+#ifndef CONTAINERS_SRC_S21_INTRUSIVE_H_
+#define CONTAINERS_SRC_S21_INTRUSIVE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "s21_comparators.h"
+#include "s21_tree_links.h"
+
+namespace s21 {
+// Intrusive containers link objects through hooks embedded in them, so
+// inserting and erasing never allocate and an object with several hooks can
+// be in several containers at once. The containers do not own the objects:
+// an object must be erased before it is destroyed, and clear() only unlinks.
+// Copying an object gives the copy unlinked hooks.
+
+struct ListHook {
+  ListHook() {}
+  ListHook(const ListHook &) {}
+  ListHook &operator=(const ListHook &) { return *this; }
+
+  bool is_linked() const { return next_; }
+
+  ListHook *next_ = nullptr;
+  ListHook *prev_ = nullptr;
+};
+
+struct SetHook {
+  SetHook() {}
+  SetHook(const SetHook &) {}
+  SetHook &operator=(const SetHook &) { return *this; }
+
+  bool is_linked() const { return parent_; }
+
+  SetHook *parent_ = nullptr;
+  SetHook *left_ = nullptr;
+  SetHook *right_ = nullptr;
+};
+
+namespace intrusive {
+// Maps a hook back to the object holding it as member Hook.
+template <class T, class H, H T::*Hook>
+T *Owner(H *hook) {
+  alignas(T) static unsigned char probe[sizeof(T)];
+  const T *object = reinterpret_cast<const T *>(probe);
+  std::ptrdiff_t offset = reinterpret_cast<const char *>(&(object->*Hook)) -
+                          reinterpret_cast<const char *>(object);
+  return reinterpret_cast<T *>(reinterpret_cast<char *>(hook) - offset);
+}
+}  // namespace intrusive
+
+// Circular doubly linked list around a sentinel hook, like List.
+template <class T, ListHook T::*Hook>
+class IntrusiveList {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+
+  class ListIterator {
+   public:
+    ListIterator() : hook_(nullptr) {}
+    explicit ListIterator(ListHook *hook) : hook_(hook) {}
+
+    reference operator*() const { return *Owner(hook_); }
+    T *operator->() const { return Owner(hook_); }
+
+    ListIterator &operator++() {
+      hook_ = hook_->next_;
+      return *this;
+    }
+
+    ListIterator operator++(int) {
+      ListIterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    ListIterator &operator--() {
+      hook_ = hook_->prev_;
+      return *this;
+    }
+
+    ListIterator operator--(int) {
+      ListIterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    bool operator==(const ListIterator &other) const {
+      return hook_ == other.hook_;
+    }
+
+    bool operator!=(const ListIterator &other) const {
+      return hook_ != other.hook_;
+    }
+
+   protected:
+    friend class IntrusiveList;
+    ListHook *hook_;
+  };
+
+  class ListConstIterator : public ListIterator {
+   public:
+    using ListIterator::ListIterator;
+    ListConstIterator(const ListIterator &other) : ListIterator(other) {}
+
+    const_reference operator*() const { return ListIterator::operator*(); }
+    const T *operator->() const { return ListIterator::operator->(); }
+  };
+
+  using iterator = ListIterator;
+  using const_iterator = ListConstIterator;
+
+  IntrusiveList() { head_.next_ = head_.prev_ = &head_; }
+
+  IntrusiveList(const IntrusiveList &) = delete;
+  IntrusiveList &operator=(const IntrusiveList &) = delete;
+
+  ~IntrusiveList() { clear(); }
+
+  reference front() const { return *Owner(head_.next_); }
+  reference back() const { return *Owner(head_.prev_); }
+
+  iterator begin() { return iterator(head_.next_); }
+  iterator end() { return iterator(&head_); }
+  const_iterator cbegin() const { return const_iterator(head_.next_); }
+  const_iterator cend() const {
+    return const_iterator(const_cast<ListHook *>(&head_));
+  }
+
+  bool empty() const { return !size_; }
+  size_type size() const { return size_; }
+
+  // The iterator to an object known to be in this list.
+  iterator iterator_to(reference value) { return iterator(&(value.*Hook)); }
+
+  void clear() {
+    ListHook *hook = head_.next_;
+    while (hook != &head_) {
+      ListHook *next = hook->next_;
+      hook->next_ = hook->prev_ = nullptr;
+      hook = next;
+    }
+    head_.next_ = head_.prev_ = &head_;
+    size_ = 0;
+  }
+
+  // value must not be linked through Hook already.
+  iterator insert(iterator pos, reference value) {
+    ListHook *hook = &(value.*Hook);
+    ListHook *next = pos.hook_;
+    hook->next_ = next;
+    hook->prev_ = next->prev_;
+    next->prev_->next_ = hook;
+    next->prev_ = hook;
+    ++size_;
+    return iterator(hook);
+  }
+
+  void erase(iterator pos) {
+    ListHook *hook = pos.hook_;
+    hook->prev_->next_ = hook->next_;
+    hook->next_->prev_ = hook->prev_;
+    hook->next_ = hook->prev_ = nullptr;
+    --size_;
+  }
+
+  void erase(reference value) { erase(iterator_to(value)); }
+
+  void push_back(reference value) { insert(end(), value); }
+  void push_front(reference value) { insert(begin(), value); }
+  void pop_back() { erase(iterator(head_.prev_)); }
+  void pop_front() { erase(iterator(head_.next_)); }
+
+  // Moves every object of other before pos.
+  void splice(const_iterator pos, IntrusiveList &other) {
+    if (this == &other || other.empty()) return;
+    ListHook *next = pos.hook_;
+    ListHook *first = other.head_.next_;
+    ListHook *last = other.head_.prev_;
+    first->prev_ = next->prev_;
+    next->prev_->next_ = first;
+    last->next_ = next;
+    next->prev_ = last;
+    size_ += other.size_;
+    other.head_.next_ = other.head_.prev_ = &other.head_;
+    other.size_ = 0;
+  }
+
+  void reverse() {
+    ListHook *hook = &head_;
+    do {
+      std::swap(hook->next_, hook->prev_);
+      hook = hook->prev_;
+    } while (hook != &head_);
+  }
+
+ private:
+  ListHook head_;
+  size_type size_ = 0;
+
+  static T *Owner(ListHook *hook) {
+    return intrusive::Owner<T, ListHook, Hook>(hook);
+  }
+};
+
+// Ordered set of distinct objects. The tree is a treap whose priorities are
+// a hash of each hook's address, so its expected depth is O(log n) whatever
+// the insertion order, without storing a priority. The root hangs from the
+// left link of a header hook that serves as end(), which lets the iterators
+// share BTree's TreeNext and TreePrev.
+template <class T, SetHook T::*Hook, class Compare = SingleComparator<T>>
+class IntrusiveSet {
+ public:
+  using key_type = T;
+  using value_type = T;
+  using key_compare = Compare;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+
+  class Iterator {
+   public:
+    Iterator() : hook_(nullptr) {}
+    explicit Iterator(SetHook *hook) : hook_(hook) {}
+
+    reference operator*() const { return *Owner(hook_); }
+    T *operator->() const { return Owner(hook_); }
+
+    Iterator &operator++() {
+      hook_ = TreeNext(hook_);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    Iterator &operator--() {
+      hook_ = TreePrev(hook_);
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return hook_ == other.hook_;
+    }
+
+    bool operator!=(const Iterator &other) const {
+      return hook_ != other.hook_;
+    }
+
+   protected:
+    friend class IntrusiveSet;
+    SetHook *hook_;
+  };
+
+  class ConstIterator : public Iterator {
+   public:
+    using Iterator::Iterator;
+    ConstIterator(const Iterator &other) : Iterator(other) {}
+
+    const_reference operator*() const { return Iterator::operator*(); }
+    const T *operator->() const { return Iterator::operator->(); }
+  };
+
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  IntrusiveSet() { header_.parent_ = &header_; }
+
+  IntrusiveSet(const IntrusiveSet &) = delete;
+  IntrusiveSet &operator=(const IntrusiveSet &) = delete;
+
+  ~IntrusiveSet() { clear(); }
+
+  iterator begin() { return iterator(Leftmost()); }
+  iterator end() { return iterator(&header_); }
+  const_iterator cbegin() const { return const_iterator(Leftmost()); }
+  const_iterator cend() const {
+    return const_iterator(const_cast<SetHook *>(&header_));
+  }
+
+  bool empty() const { return !size_; }
+  size_type size() const { return size_; }
+
+  iterator iterator_to(reference value) { return iterator(&(value.*Hook)); }
+
+  // Unlinks every object by unrolling the tree into a right vine, as
+  // BTree::DestroyNodes does.
+  void clear() {
+    SetHook *hook = header_.left_;
+    while (hook) {
+      if (SetHook *left = hook->left_) {
+        hook->left_ = left->right_;
+        left->right_ = hook;
+        hook = left;
+      } else {
+        SetHook *right = hook->right_;
+        hook->parent_ = hook->right_ = nullptr;
+        hook = right;
+      }
+    }
+    header_.left_ = nullptr;
+    size_ = 0;
+  }
+
+  // If an equal object is already linked, returns it and leaves value
+  // unlinked.
+  std::pair<iterator, bool> insert(reference value) {
+    SetHook *parent = &header_;
+    SetHook **link = &header_.left_;
+    while (*link) {
+      parent = *link;
+      const T &key = *Owner(parent);
+      if (comparator_.LessThan(value, key))
+        link = &parent->left_;
+      else if (comparator_.LessThan(key, value))
+        link = &parent->right_;
+      else
+        return std::pair<iterator, bool>(iterator(parent), false);
+    }
+    SetHook *hook = &(value.*Hook);
+    hook->parent_ = parent;
+    hook->left_ = hook->right_ = nullptr;
+    *link = hook;
+    while (hook->parent_ != &header_ &&
+           Priority(hook) > Priority(hook->parent_))
+      RotateUp(hook);
+    ++size_;
+    return std::pair<iterator, bool>(iterator(hook), true);
+  }
+
+  void erase(iterator pos) {
+    SetHook *hook = pos.hook_;
+    while (hook->left_ && hook->right_)
+      RotateUp(Priority(hook->left_) > Priority(hook->right_) ? hook->left_
+                                                              : hook->right_);
+    SetHook *child = hook->left_ ? hook->left_ : hook->right_;
+    SetHook *parent = hook->parent_;
+    (parent->left_ == hook ? parent->left_ : parent->right_) = child;
+    if (child) child->parent_ = parent;
+    hook->parent_ = hook->left_ = hook->right_ = nullptr;
+    --size_;
+  }
+
+  void erase(reference value) { erase(iterator_to(value)); }
+
+  iterator find(const_reference key) {
+    SetHook *hook = LowerBound(key);
+    if (hook != &header_ && comparator_.LessThan(key, *Owner(hook)))
+      hook = &header_;
+    return iterator(hook);
+  }
+
+  bool contains(const_reference key) { return find(key) != end(); }
+
+  iterator lower_bound(const_reference key) {
+    return iterator(LowerBound(key));
+  }
+
+ private:
+  SetHook header_;
+  size_type size_ = 0;
+  key_compare comparator_;
+
+  static T *Owner(SetHook *hook) {
+    return intrusive::Owner<T, SetHook, Hook>(hook);
+  }
+
+  static uint64_t Priority(const SetHook *hook) {
+    return (uint64_t)(uintptr_t)hook * 0x9e3779b97f4a7c15u;
+  }
+
+  SetHook *Leftmost() const {
+    SetHook *hook = const_cast<SetHook *>(&header_);
+    while (hook->left_) hook = hook->left_;
+    return hook;
+  }
+
+  SetHook *LowerBound(const_reference key) {
+    SetHook *result = &header_;
+    SetHook *hook = header_.left_;
+    while (hook) {
+      if (comparator_.LessThan(*Owner(hook), key)) {
+        hook = hook->right_;
+      } else {
+        result = hook;
+        hook = hook->left_;
+      }
+    }
+    return result;
+  }
+
+  // Swaps hook with its parent, keeping the in-order sequence.
+  static void RotateUp(SetHook *hook) {
+    SetHook *parent = hook->parent_;
+    SetHook *grand = parent->parent_;
+    if (parent->left_ == hook) {
+      parent->left_ = hook->right_;
+      if (hook->right_) hook->right_->parent_ = parent;
+      hook->right_ = parent;
+    } else {
+      parent->right_ = hook->left_;
+      if (hook->left_) hook->left_->parent_ = parent;
+      hook->left_ = parent;
+    }
+    parent->parent_ = hook;
+    hook->parent_ = grand;
+    (grand->left_ == parent ? grand->left_ : grand->right_) = hook;
+  }
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_INTRUSIVE_H_
@@ -4,6 +4,9 @@
 #include <iostream>
 #include <limits>
 
+#include "s21_instrumentation.h"
+#include "s21_node_arena.h"
+
 namespace s21 {
 template <typename T>
 class List {
@@ -18,7 +21,7 @@ class List {
     Node() : content_(0), next_(this), prev_(this) {}
 
     Node(value_type value, Node* next, Node* prev)
-        : content_(value), next_(next), prev_(prev) {}
+        : content_(std::move(value)), next_(next), prev_(prev) {}
 
     Node(const Node& other)
         : content_(other.get_content()),
@@ -289,6 +292,7 @@ class List {
         it = tmp;
       }
     }
+    blocks_.clear();
   }
 
   iterator insert(iterator pos, const_reference value) {
@@ -297,6 +301,7 @@ class List {
     Node* tmp = new Node(value, next, prev);
     prev->set_next(tmp);
     next->set_prev(tmp);
+    S21_COUNT(list_inserts, 1);
     ++size_;
     return iterator(tmp);
   }
@@ -306,8 +311,9 @@ class List {
     Node* next = (pos + 1).node();
     next->set_prev(prev);
     prev->set_next(next);
+    S21_COUNT(list_erases, 1);
     --size_;
-    delete pos.node();
+    blocks_.Free(pos.node());
   }
 
   void push_back(const_reference value) { insert(this->end(), value); }
@@ -332,6 +338,7 @@ class List {
     size_type size_temp = size_;
     size_ = other.size();
     other.size_ = size_temp;
+    blocks_.swap(other.blocks_);
   }
 
   void merge(List& other) {
@@ -351,6 +358,10 @@ class List {
         ++it_1;
       }
     }
+    if (this != &other) {
+      blocks_.Share(other.blocks_);
+      other.blocks_.clear();
+    }
   }
 
   void splice(const_iterator pos, List& other) {
@@ -358,6 +369,7 @@ class List {
       List<Node*> other_nodes;
       List<Node*> zero;
       other.ExtractNodes(other_nodes);
+      size_ += other.size_;
       other.size_ = 0;
       other.InsertNodes(zero);
 
@@ -370,7 +382,28 @@ class List {
       Node* last = other_nodes.back();
       first->set_prev(prev);
       last->set_next(next);
+      blocks_.Share(other.blocks_);
+      other.blocks_.clear();
+    }
+  }
+
+  // Moves every node into one contiguous block in iteration order.
+  // Invalidates all iterators.
+  void compact() {
+    if (!size_) return;
+    Node* block = blocks_.Allocate<Node>(size_);
+    Node* prev = node_null_;
+    Node* old = node_null_->get_next();
+    for (size_type i = 0; i < size_; ++i) {
+      Node* next = old->get_next();
+      Node* node =
+          new (block + i) Node(std::move(old->get_content_ref()), next, prev);
+      prev->set_next(node);
+      blocks_.Free(old);
+      prev = node;
+      old = next;
     }
+    node_null_->set_prev(prev);
   }
 
   void reverse() {
@@ -420,6 +453,8 @@ class List {
  private:
   size_type size_ = 0;
   Node* node_null_ = new Node;
+  // Blocks made by compact(), here or in lists nodes came from.
+  s21::arena::Blocks blocks_;
 
   void ExtractNodes(List<Node*>& dest) {
     if (size_ > 0) {
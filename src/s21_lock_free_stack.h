@@ -0,0 +1,196 @@
+#ifndef CONTAINERS_SRC_S21_LOCK_FREE_STACK_H_
+#define CONTAINERS_SRC_S21_LOCK_FREE_STACK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace s21 {
+// Treiber stack for many threads. Each link word packs a node address into
+// the low 48 bits and a version tag into the high 16; every successful CAS
+// bumps the tag, so a node that was popped and pushed back in between is not
+// mistaken for the old head (ABA). Popped nodes go to an internal free list
+// instead of being deleted, so a thread still holding a stale head can read
+// its next link safely; memory is released by the destructor.
+//
+// When the head CAS fails under contention, the thread tries an elimination
+// slot: a push and a pop that meet there hand the value over directly and
+// never touch the head.
+template <typename T>
+class LockFreeStack {
+  static_assert(sizeof(void *) == 8,
+                "s21::LockFreeStack packs tags into 64-bit pointers");
+
+ public:
+  using value_type = T;
+  using const_reference = const T &;
+  using size_type = size_t;
+
+  LockFreeStack() {}
+
+  LockFreeStack(const LockFreeStack &) = delete;
+  LockFreeStack &operator=(const LockFreeStack &) = delete;
+
+  ~LockFreeStack() {
+    for (Node *node = Address(head_.load()); node;) {
+      Node *next = node->next_.load(std::memory_order_relaxed);
+      node->Value().~T();
+      delete node;
+      node = next;
+    }
+    for (Node *node = Address(free_.load()); node;) {
+      Node *next = node->next_.load(std::memory_order_relaxed);
+      delete node;
+      node = next;
+    }
+  }
+
+  void push(const_reference value) { Push(value); }
+  void push(T &&value) { Push(std::move(value)); }
+
+  // Returns false if the stack was empty.
+  bool try_pop(T &value) {
+    Node *node = Pop();
+    if (!node) return false;
+    value = std::move(node->Value());
+    node->Value().~T();
+    Recycle(node);
+    return true;
+  }
+
+  // Only a hint while other threads push or pop.
+  bool empty() const { return !Address(head_.load(std::memory_order_acquire)); }
+
+ private:
+  struct Node {
+    std::atomic<Node *> next_{nullptr};
+    alignas(T) unsigned char storage_[sizeof(T)];
+
+    T &Value() { return *reinterpret_cast<T *>(storage_); }
+  };
+
+  using Tagged = uint64_t;
+
+  static constexpr Tagged kAddressMask = (Tagged(1) << 48) - 1;
+  static constexpr Tagged kTagUnit = Tagged(1) << 48;
+  static constexpr size_t kSlots = 16;
+  static constexpr int kSlotSpins = 64;
+
+  // One cache line each, so slots do not false-share.
+  struct alignas(64) Slot {
+    std::atomic<Tagged> word{0};
+  };
+
+  alignas(64) std::atomic<Tagged> head_{0};
+  alignas(64) std::atomic<Tagged> free_{0};
+  Slot slots_[kSlots];
+
+  static Node *Address(Tagged word) { return (Node *)(word & kAddressMask); }
+
+  static Tagged Next(Tagged word, Node *node) {
+    return ((word & ~kAddressMask) + kTagUnit) | (Tagged)(uintptr_t)node;
+  }
+
+  static void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+  }
+
+  static size_t RandomSlot() {
+    thread_local uint32_t state = 0x9e3779b9u ^ (uint32_t)(uintptr_t)&state;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state % kSlots;
+  }
+
+  template <class U>
+  void Push(U &&value) {
+    Node *node = Pop(free_);
+    if (!node) node = new Node;
+    new (node->storage_) T(std::forward<U>(value));
+    Tagged head = head_.load(std::memory_order_relaxed);
+    while (true) {
+      node->next_.store(Address(head), std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(head, Next(head, node),
+                                      std::memory_order_release,
+                                      std::memory_order_relaxed))
+        return;
+      if (Eliminate(node)) return;
+      head = head_.load(std::memory_order_relaxed);
+    }
+  }
+
+  Node *Pop() {
+    Tagged head = head_.load(std::memory_order_acquire);
+    while (Node *node = Address(head)) {
+      Node *next = node->next_.load(std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(head, Next(head, next),
+                                      std::memory_order_acquire,
+                                      std::memory_order_acquire))
+        return node;
+      if ((node = Collect())) return node;
+      head = head_.load(std::memory_order_acquire);
+    }
+    return nullptr;
+  }
+
+  // The free list is a plain Treiber stack with the same tagging.
+  static Node *Pop(std::atomic<Tagged> &list) {
+    Tagged head = list.load(std::memory_order_acquire);
+    while (Node *node = Address(head)) {
+      Node *next = node->next_.load(std::memory_order_relaxed);
+      if (list.compare_exchange_weak(head, Next(head, next),
+                                     std::memory_order_acquire,
+                                     std::memory_order_acquire))
+        return node;
+    }
+    return nullptr;
+  }
+
+  void Recycle(Node *node) {
+    Tagged head = free_.load(std::memory_order_relaxed);
+    do {
+      node->next_.store(Address(head), std::memory_order_relaxed);
+    } while (!free_.compare_exchange_weak(head, Next(head, node),
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+  }
+
+  // Offers node in a random empty slot for a while. Returns true if a popper
+  // took it, false if the offer was withdrawn.
+  bool Eliminate(Node *node) {
+    Slot &slot = slots_[RandomSlot()];
+    Tagged empty = slot.word.load(std::memory_order_relaxed);
+    if (Address(empty)) return false;
+    Tagged offer = Next(empty, node);
+    if (!slot.word.compare_exchange_strong(empty, offer,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed))
+      return false;
+    for (int i = 0; i < kSlotSpins; ++i) {
+      if (slot.word.load(std::memory_order_relaxed) != offer) return true;
+      CpuRelax();
+    }
+    return !slot.word.compare_exchange_strong(offer, Next(offer, nullptr),
+                                              std::memory_order_relaxed,
+                                              std::memory_order_relaxed);
+  }
+
+  // Takes a node offered by a concurrent push, if the random slot holds one.
+  Node *Collect() {
+    Slot &slot = slots_[RandomSlot()];
+    Tagged offer = slot.word.load(std::memory_order_acquire);
+    Node *node = Address(offer);
+    if (node && slot.word.compare_exchange_strong(offer, Next(offer, nullptr),
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_relaxed))
+      return node;
+    return nullptr;
+  }
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_LOCK_FREE_STACK_H_
@@ -4,9 +4,12 @@
 #include <iostream>
 
 #include "s21_btree.h"
+#include "s21_compact_btree.h"
+#include "s21_frozen.h"
 
 namespace s21 {
-template <class Key, class T, class Compare = s21::PairComparator<Key, T>>
+template <class Key, class T, class Compare = s21::PairComparator<Key, T>,
+          class Nodes = PointerNodes>
 class Map : public BTree<std::pair<Key, T>, Compare> {
  public:
   using key_type = Key;
@@ -20,9 +23,11 @@ class Map : public BTree<std::pair<Key, T>, Compare> {
   using size_type = size_t;
   using tree_node = typename BTree<value_type, Compare>::Node;
 
+  using BTree<value_type, Compare>::erase;
+
   Map() {
-    this->end_null_ = new tree_node(value_type(0, 0));
-    this->begin_null_ = new tree_node(value_type(0, 0));
+    this->end_null_ = new tree_node(value_type());
+    this->begin_null_ = new tree_node(value_type());
     this->begin_null_->parent_ = this->end_null_;
     this->end_null_->parent_ = this->begin_null_;
   }
@@ -54,24 +59,11 @@ class Map : public BTree<std::pair<Key, T>, Compare> {
     return *this;
   }
 
-  T& at(const Key& key) {
-    auto it = this->begin();
-    if (this->contains(key)) {
-      while ((*it).first != key) ++it;
-    } else {
-      throw std::out_of_range("s21::map::at");
-    }
-    return (*it).second;
-  }
+  T& at(const Key& key) { return At(key); }
 
   T& operator[](const Key& key) {
-    auto it = this->begin();
-    while ((*it).first != key && it != this->end()) ++it;
-    if (it == this->end()) {
-      auto pair = this->insert(key, 0);
-      it = pair.first;
-    }
-    return (*it).second;
+    if (tree_node* node = FindKey(key)) return node->data_.second;
+    return (*this->InsertOrPaste(value_type(key, T())).first).second;
   }
 
   std::pair<iterator, bool> insert(const value_type& value) {
@@ -83,6 +75,16 @@ class Map : public BTree<std::pair<Key, T>, Compare> {
     return this->InsertOrPaste(pair);
   }
 
+  iterator insert(iterator hint, const value_type& value) {
+    return this->InsertWithHint(hint, value).first;
+  }
+
+  template <class... Args>
+  iterator emplace_hint(iterator hint, Args&&... args) {
+    return this->InsertWithHint(hint, value_type(std::forward<Args>(args)...))
+        .first;
+  }
+
   std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
     value_type pair(key, obj);
     std::pair<iterator, bool> pp = this->InsertOrPaste(pair);
@@ -90,6 +92,24 @@ class Map : public BTree<std::pair<Key, T>, Compare> {
     return pp;
   }
 
+  void erase(iterator first, iterator last) {
+    if (first != last)
+      this->EraseBetween(*first, last == this->end() ? nullptr : &*last);
+  }
+
+  size_type erase_range(const Key& lo, const Key& hi) {
+    const auto& hi_probe = Probe(hi);
+    return this->EraseBetween(Probe(lo), &hi_probe);
+  }
+
+  Map split(const Key& key) {
+    Map upper;
+    this->SplitTree(Probe(key), upper);
+    return upper;
+  }
+
+  void join(Map& other) { this->JoinTree(other); }
+
   void merge(Map& other) {
     auto it = other.begin();
     while (it != other.end()) {
@@ -100,14 +120,264 @@ class Map : public BTree<std::pair<Key, T>, Compare> {
       }
       it = tmp;
     }
+    this->ShareBlocks(other);
+  }
+
+  // The snapshot orders keys as Compare orders the pairs; see KeyComparator.
+  FrozenMap<Key, T, KeyComparator<Key, T, Compare>> freeze() {
+    return FrozenMap<Key, T, KeyComparator<Key, T, Compare>>(this->begin(),
+                                                             this->size());
+  }
+
+  // Writes all keys in order and then all values, so a trivially copyable
+  // map can be searched in place through a MappedMap with the same Compare.
+  // Values are gathered while the keys are written to walk the tree only
+  // once.
+  void save(const std::string& path) {
+    snapshot::Writer writer(path);
+    writer.Begin(snapshot::kMap, snapshot::SizeOf<Key>(),
+                 snapshot::SizeOf<T>(), this->size());
+    Vector<T> values;
+    values.reserve(this->size());
+    for (auto it = this->begin(); it != this->end(); ++it) {
+      writer.Write((*it).first);
+      values.push_back((*it).second);
+    }
+    writer.Align();
+    writer.WriteArray(values.data(), values.size());
+    writer.Close();
+  }
+
+  void load(const std::string& path) {
+    snapshot::Reader reader(path);
+    uint64_t n = reader.Begin(snapshot::kMap, snapshot::SizeOf<Key>(),
+                              snapshot::SizeOf<T>());
+    Vector<Key> keys;
+    keys.reserve(n);
+    Key key;
+    for (uint64_t i = 0; i < n; ++i) {
+      reader.Read(key);
+      keys.push_back(key);
+    }
+    reader.Align();
+    Map loaded;
+    T value;
+    for (uint64_t i = 0; i < n; ++i) {
+      reader.Read(value);
+      loaded.InsertOrPaste(value_type(keys[i], value));
+    }
+    loaded.rebalance();
+    this->InheritBloom(loaded);
+    this->clear();
+    this->swap(loaded);
+  }
+
+  iterator find(const Key& key) { return Find(key); }
+  bool contains(const Key& key) { return FindKey(key); }
+  size_type count(const Key& key) { return contains(key); }
+  iterator lower_bound(const Key& key) { return LowerBoundKey(key); }
+
+  // Lookups by text, such as a std::string_view for std::string keys,
+  // without building a Key or a pair; see IsKeyProbe.
+  template <class K, class C = Compare, class = typename C::is_transparent,
+            class = EnableIfKeyProbe<Key, K>>
+  T& at(const K& key) {
+    return At(key);
+  }
+  template <class K, class C = Compare, class = typename C::is_transparent,
+            class = EnableIfKeyProbe<Key, K>>
+  iterator find(const K& key) {
+    return Find(key);
+  }
+  template <class K, class C = Compare, class = typename C::is_transparent,
+            class = EnableIfKeyProbe<Key, K>>
+  bool contains(const K& key) {
+    return FindKey(key);
+  }
+  template <class K, class C = Compare, class = typename C::is_transparent,
+            class = EnableIfKeyProbe<Key, K>>
+  size_type count(const K& key) {
+    return contains(key);
+  }
+  template <class K, class C = Compare, class = typename C::is_transparent,
+            class = EnableIfKeyProbe<Key, K>>
+  iterator lower_bound(const K& key) {
+    return LowerBoundKey(key);
+  }
+
+  // Batched find: out[i] is the iterator to the pair with key keys[i], or
+  // end(). The descents of the batch are interleaved; see
+  // BTree::SearchMany.
+  void find_many(const Vector<Key>& keys, Vector<iterator>& out) {
+    Vector<iterator> found(keys.size());
+    this->SearchMany(keys.data(), keys.size(), KeyLess(this),
+                     [&](size_type i, tree_node* node) {
+                       found[i] = node ? iterator(node) : this->end();
+                     });
+    out.swap(found);
+  }
+
+  // Batched contains; returns how many of keys are present.
+  size_type contains_many(const Vector<Key>& keys, Vector<bool>& out) {
+    Vector<bool> found(keys.size());
+    size_type hits = 0;
+    this->SearchMany(keys.data(), keys.size(), KeyLess(this),
+                     [&](size_type i, tree_node* node) {
+                       found[i] = node;
+                       hits += (bool)node;
+                     });
+    out.swap(found);
+    return hits;
+  }
+
+ private:
+  // What lookups compare against the stored pairs: the key itself when the
+  // comparator is transparent, otherwise a pair wrapping it.
+  template <class K>
+  decltype(auto) Probe(const K& key) const {
+    if constexpr (IsTransparent<Compare>::value)
+      return key;
+    else
+      return value_type(key, T());
+  }
+
+  template <class K>
+  tree_node* FindKey(const K& key) {
+    if (this->BloomRejects(key)) return nullptr;
+    return this->FindNode(Probe(key));
+  }
+
+  template <class K>
+  iterator Find(const K& key) {
+    tree_node* node = FindKey(key);
+    return node ? iterator(node) : this->end();
+  }
+
+  template <class K>
+  T& At(const K& key) {
+    tree_node* node = FindKey(key);
+    if (!node) throw std::out_of_range("s21::map::at");
+    return node->data_.second;
+  }
+
+  template <class K>
+  iterator LowerBoundKey(const K& key) {
+    return iterator(this->LowerBound(Probe(key)));
+  }
+
+  struct KeyLess {
+    Map* map_;
+
+    explicit KeyLess(Map* map) : map_(map) {}
+    bool operator()(const Key& a, const value_type& b) const {
+      return Less(a, b);
+    }
+    bool operator()(const value_type& a, const Key& b) const {
+      return Less(a, b);
+    }
+
+    template <class A, class B>
+    bool Less(const A& a, const B& b) const {
+      if constexpr (IsTransparent<Compare>::value)
+        return map_->comparator_.LessThan(a, b);
+      else
+        return map_->comparator_.LessThan(Wrap(a), Wrap(b));
+    }
+
+    static const value_type& Wrap(const value_type& pair) { return pair; }
+    static value_type Wrap(const Key& key) { return value_type(key, T()); }
+  };
+};
+
+// Values live in the node pool, which may move when an insert grows it:
+// references returned by at(), operator[] and operator* are invalidated by
+// any insert of a new key, while iterators stay valid.
+template <class Key, class T, class Compare>
+class Map<Key, T, Compare, CompactNodes>
+    : public CompactBTree<std::pair<Key, T>, Compare> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename CompactBTree<value_type, Compare>::Iterator;
+  using const_iterator =
+      typename CompactBTree<value_type, Compare>::ConstIterator;
+  using size_type = size_t;
+
+  Map() {}
+
+  Map(std::initializer_list<value_type> const& items) {
+    for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
+  }
+
+  Map(const Map& other) {
+    for (auto it = other.cbegin(); it != other.cend(); ++it) this->insert(*it);
+  }
+
+  Map(Map&& other) { this->swap(other); }
+
+  Map& operator=(Map&& other) {
+    this->clear();
+    this->swap(other);
+    return *this;
+  }
+
+  Map& operator=(const Map& other) {
+    if (this != &other) {
+      this->clear();
+      for (auto it = other.cbegin(); it != other.cend(); ++it)
+        this->insert(*it);
+    }
+    return *this;
+  }
+
+  T& at(const Key& key) {
+    auto node = this->Search(value_type(key, T()));
+    if (node == this->kNull) throw std::out_of_range("s21::map::at");
+    return this->pool_[node].data_.second;
+  }
+
+  T& operator[](const Key& key) {
+    return (*this->InsertOrPaste(value_type(key, T())).first).second;
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return this->InsertOrPaste(value);
+  }
+
+  std::pair<iterator, bool> insert(const Key& key, const T& obj) {
+    return this->InsertOrPaste(value_type(key, obj));
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
+    std::pair<iterator, bool> result = this->insert(key, obj);
+    if (!result.second) (*result.first).second = obj;
+    return result;
+  }
+
+  void merge(Map& other) {
+    auto it = other.begin();
+    while (it != other.end()) {
+      auto tmp = it + 1;
+      if (this->insert(*it).second) other.erase(it);
+      it = tmp;
+    }
+  }
+
+  FrozenMap<Key, T, KeyComparator<Key, T, Compare>> freeze() {
+    return FrozenMap<Key, T, KeyComparator<Key, T, Compare>>(this->begin(),
+                                                             this->size());
+  }
+
+  iterator find(const Key& key) {
+    return iterator(this, this->Search(value_type(key, T())));
   }
 
-  bool contains(const Key& key) {
-    bool flag = true;
-    auto it = this->begin();
-    while ((*it).first != key && it != this->end()) ++it;
-    if (it == this->end()) flag = false;
-    return flag;
+  bool contains(const Key& key) const {
+    return this->Search(value_type(key, T())) != this->kNull;
   }
 };
 }  // namespace s21
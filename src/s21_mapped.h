@@ -0,0 +1,243 @@
+#ifndef CONTAINERS_SRC_S21_MAPPED_H_
+#define CONTAINERS_SRC_S21_MAPPED_H_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "s21_comparators.h"
+#include "s21_snapshot.h"
+
+namespace s21 {
+// Read-only views over snapshot files written by save(). The file is mapped
+// rather than read, so opening one costs a few system calls regardless of
+// its size and pages are faulted in only as lookups touch them. Only
+// trivially copyable element types can be viewed this way.
+class MappedFile {
+ public:
+  MappedFile() {}
+
+  explicit MappedFile(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error("s21::MappedFile: cannot open " + path);
+    struct stat info;
+    if (::fstat(fd, &info) < 0 ||
+        (size_t)info.st_size < sizeof(snapshot::Header)) {
+      ::close(fd);
+      throw std::runtime_error("s21::load: truncated snapshot");
+    }
+    size_ = info.st_size;
+    void *data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+      throw std::runtime_error("s21::MappedFile: cannot map " + path);
+    data_ = (const char *)data;
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  MappedFile(MappedFile &&other) { swap(other); }
+
+  MappedFile &operator=(MappedFile &&other) {
+    swap(other);
+    return *this;
+  }
+
+  ~MappedFile() {
+    if (data_) ::munmap((void *)data_, size_);
+  }
+
+  void swap(MappedFile &other) {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+  }
+
+  const snapshot::Header &Header() const {
+    return *(const snapshot::Header *)data_;
+  }
+
+  // Validates the header and returns the address of the array that starts
+  // at offset, checking that count elements of element_size fit in the file.
+  const char *Array(snapshot::Kind kind, uint32_t key_size,
+                    uint32_t value_size, size_t offset,
+                    size_t element_size) const {
+    snapshot::Reader::Check(Header(), kind, key_size, value_size);
+    ArrayEnd(offset, element_size);
+    return data_ + offset;
+  }
+
+  // Offset just past count elements of element_size starting at offset.
+  // Throws if they do not fit in the file; the count comes from the file, so
+  // the check divides rather than multiplies to rule out overflow.
+  size_t ArrayEnd(size_t offset, size_t element_size) const {
+    uint64_t count = Header().count;
+    if (offset > size_ || count > (size_ - offset) / element_size)
+      throw std::runtime_error("s21::load: truncated snapshot");
+    return offset + count * element_size;
+  }
+
+ private:
+  const char *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+template <class T>
+class MappedVector {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "only trivially copyable types can be mapped");
+
+ public:
+  using value_type = T;
+  using const_reference = const T &;
+  using const_iterator = const T *;
+  using size_type = size_t;
+
+  explicit MappedVector(const std::string &path) : file_(path) {
+    data_ = (const T *)file_.Array(snapshot::kVector, sizeof(T), 0,
+                                   sizeof(snapshot::Header), sizeof(T));
+    size_ = file_.Header().count;
+  }
+
+  const_reference operator[](size_type pos) const { return data_[pos]; }
+
+  const_reference at(size_type pos) const {
+    if (pos >= size_) throw std::out_of_range("s21::MappedVector::at");
+    return data_[pos];
+  }
+
+  const T *data() const { return data_; }
+  const_iterator begin() const { return data_; }
+  const_iterator end() const { return data_ + size_; }
+  bool empty() const { return !size_; }
+  size_type size() const { return size_; }
+
+ private:
+  MappedFile file_;
+  const T *data_;
+  size_type size_;
+};
+
+// Sorted keys at the start of a Set or Map snapshot.
+template <class Key, class Compare = SingleComparator<Key>>
+class MappedKeys {
+  static_assert(std::is_trivially_copyable<Key>::value,
+                "only trivially copyable types can be mapped");
+
+ public:
+  using key_type = Key;
+  using const_iterator = const Key *;
+  using size_type = size_t;
+
+  bool empty() const { return !size_; }
+  size_type size() const { return size_; }
+
+ protected:
+  MappedFile file_;
+  const Key *keys_;
+  size_type size_;
+  Compare comparator_;
+
+  MappedKeys(const std::string &path, snapshot::Kind kind, uint32_t value_size)
+      : file_(path) {
+    keys_ = (const Key *)file_.Array(kind, sizeof(Key), value_size,
+                                     sizeof(snapshot::Header), sizeof(Key));
+    size_ = file_.Header().count;
+  }
+
+  // Branch-free: the loop runs log2(n) times whatever the key.
+  size_type LowerBound(const Key &key) const {
+    const Key *base = keys_;
+    size_type n = size_;
+    while (n > 1) {
+      size_type half = n / 2;
+      base = comparator_.LessThan(base[half - 1], key) ? base + half : base;
+      n -= half;
+    }
+    return (base - keys_) + (n == 1 && comparator_.LessThan(*base, key));
+  }
+
+  // Position of key, or size_ if it is absent.
+  size_type Find(const Key &key) const {
+    size_type pos = LowerBound(key);
+    return pos < size_ && !comparator_.LessThan(key, keys_[pos]) ? pos : size_;
+  }
+};
+
+template <class Key, class Compare = SingleComparator<Key>>
+class MappedSet : public MappedKeys<Key, Compare> {
+ public:
+  using value_type = Key;
+  using const_iterator = const Key *;
+
+  explicit MappedSet(const std::string &path)
+      : MappedKeys<Key, Compare>(path, snapshot::kSet, 0) {}
+
+  const_iterator begin() const { return this->keys_; }
+  const_iterator end() const { return this->keys_ + this->size_; }
+
+  const_iterator lower_bound(const Key &key) const {
+    return this->keys_ + this->LowerBound(key);
+  }
+
+  const_iterator find(const Key &key) const {
+    return this->keys_ + this->Find(key);
+  }
+
+  bool contains(const Key &key) const {
+    return this->Find(key) != this->size_;
+  }
+};
+
+// Keys and values live in separate arrays, as Map::save() writes them, so a
+// search touches only the keys. Compare must be that of the saved Map.
+template <class Key, class T, class Compare = PairComparator<Key, T>>
+class MappedMap : public MappedKeys<Key, KeyComparator<Key, T, Compare>> {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "only trivially copyable types can be mapped");
+
+ public:
+  using mapped_type = T;
+  using size_type = size_t;
+
+  explicit MappedMap(const std::string &path)
+      : MappedKeys<Key, KeyComparator<Key, T, Compare>>(path, snapshot::kMap,
+                                                        sizeof(T)) {
+    size_type offset = snapshot::AlignUp(
+        this->file_.ArrayEnd(sizeof(snapshot::Header), sizeof(Key)));
+    values_ = (const T *)this->file_.Array(snapshot::kMap, sizeof(Key),
+                                           sizeof(T), offset, sizeof(T));
+  }
+
+  const Key &key(size_type pos) const { return this->keys_[pos]; }
+  const T &value(size_type pos) const { return values_[pos]; }
+
+  // Pointer to the value of key, or nullptr if it is absent.
+  const T *find(const Key &key) const {
+    size_type pos = this->Find(key);
+    return pos != this->size_ ? values_ + pos : nullptr;
+  }
+
+  bool contains(const Key &key) const {
+    return this->Find(key) != this->size_;
+  }
+
+  const T &at(const Key &key) const {
+    const T *value = find(key);
+    if (!value) throw std::out_of_range("s21::MappedMap::at");
+    return *value;
+  }
+
+ private:
+  const T *values_;
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_MAPPED_H_
@@ -0,0 +1,143 @@
+#ifndef CONTAINERS_SRC_S21_MULTIMAP_H_
+#define CONTAINERS_SRC_S21_MULTIMAP_H_
+
+#include <iostream>
+
+#include "s21_btree.h"
+
+namespace s21 {
+template <class Key, class T, class Compare = s21::PairComparator<Key, T>>
+class Multimap : public BTree<std::pair<Key, T>, Compare> {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<key_type, mapped_type>;
+  using key_compare = Compare;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename BTree<value_type, key_compare>::Iterator;
+  using const_iterator = typename BTree<value_type, key_compare>::ConstIterator;
+  using size_type = size_t;
+  using tree_node = typename BTree<value_type, Compare>::Node;
+
+  using BTree<value_type, Compare>::erase;
+
+  Multimap() {
+    this->end_null_ = new tree_node(value_type());
+    this->begin_null_ = new tree_node(value_type());
+    this->begin_null_->parent_ = this->end_null_;
+    this->end_null_->parent_ = this->begin_null_;
+  }
+
+  Multimap(std::initializer_list<value_type> const& items) : Multimap() {
+    for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
+  }
+
+  Multimap(const Multimap& other) : Multimap() {
+    for (auto it = other.cbegin(); it != other.cend(); ++it) this->insert(*it);
+  }
+
+  Multimap(Multimap&& other) : Multimap() { this->swap(other); }
+
+  ~Multimap() {
+    this->clear();
+    delete this->end_null_;
+    delete this->begin_null_;
+  }
+
+  Multimap& operator=(Multimap&& other) {
+    this->clear();
+    this->swap(other);
+    return *this;
+  }
+
+  Multimap& operator=(const Multimap& other) {
+    if (this != &other) {
+      this->clear();
+      for (auto it = other.cbegin(); it != other.cend(); ++it)
+        this->insert(*it);
+    }
+    return *this;
+  }
+
+  iterator insert(const value_type& value) { return this->InsertEqual(value); }
+
+  iterator insert(const Key& key, const T& obj) {
+    return this->InsertEqual(value_type(key, obj));
+  }
+
+  template <class... Args>
+  iterator emplace(Args&&... args) {
+    return this->InsertEqual(value_type(std::forward<Args>(args)...));
+  }
+
+  size_type erase(const Key& key) {
+    size_type count = 0;
+    iterator it = lower_bound(key);
+    while (it != this->end() && Equivalent(key, *it)) {
+      iterator tmp = it + 1;
+      erase(it);
+      it = tmp;
+      ++count;
+    }
+    return count;
+  }
+
+  void merge(Multimap& other) {
+    auto it = other.begin();
+    while (it != other.end()) {
+      auto tmp = it + 1;
+      other.DeleteOrExtract(it, false);
+      this->InsertEqual(*it, it.node());
+      it = tmp;
+    }
+    this->ShareBlocks(other);
+  }
+
+  size_type count(const Key& key) {
+    size_type count = 0;
+    for (iterator it = lower_bound(key);
+         it != this->end() && Equivalent(key, *it); ++it)
+      ++count;
+    return count;
+  }
+
+  iterator find(const Key& key) {
+    iterator it = lower_bound(key);
+    if (it != this->end() && !Equivalent(key, *it)) it = this->end();
+    return it;
+  }
+
+  bool contains(const Key& key) { return find(key) != this->end(); }
+
+  std::pair<iterator, iterator> equal_range(const Key& key) {
+    return std::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+  }
+
+  iterator lower_bound(const Key& key) {
+    return iterator(this->LowerBound(Probe(key)));
+  }
+
+  iterator upper_bound(const Key& key) {
+    return iterator(this->UpperBound(Probe(key)));
+  }
+
+ private:
+  // What lookups compare against the stored pairs: the key itself when the
+  // comparator is transparent, otherwise a pair wrapping it.
+  decltype(auto) Probe(const Key& key) const {
+    if constexpr (IsTransparent<Compare>::value)
+      return key;
+    else
+      return value_type(key, mapped_type());
+  }
+
+  // For a value at or after lower_bound(key): whether it is equivalent to
+  // key under the comparator, which may differ from operator==.
+  bool Equivalent(const Key& key, const value_type& value) const {
+    return !this->comparator_.LessThan(Probe(key), value);
+  }
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_MULTIMAP_H_
@@ -0,0 +1,122 @@
+#ifndef CONTAINERS_SRC_S21_MULTISET_H_
+#define CONTAINERS_SRC_S21_MULTISET_H_
+
+#include <iostream>
+
+#include "s21_btree.h"
+
+namespace s21 {
+template <typename Key, class Compare = s21::SingleComparator<Key>>
+class Multiset : public BTree<Key, Compare> {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = size_t;
+  using iterator = typename BTree<Key, Compare>::Iterator;
+  using const_iterator = typename BTree<Key, Compare>::ConstIterator;
+  using tree_node = typename BTree<Key, Compare>::Node;
+
+  using BTree<Key, Compare>::erase;
+
+  Multiset() {
+    this->end_null_ = new tree_node(value_type());
+    this->begin_null_ =
+        new tree_node(value_type(), nullptr, nullptr, this->end_null_);
+    this->end_null_->parent_ = this->begin_null_;
+  }
+
+  Multiset(std::initializer_list<value_type> const& items) : Multiset() {
+    for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
+  }
+
+  Multiset(const Multiset& other) : Multiset() {
+    for (auto it = other.cbegin(); it != other.cend(); ++it) this->insert(*it);
+  }
+
+  Multiset(Multiset&& other) : Multiset() { this->swap(other); }
+
+  ~Multiset() {
+    this->clear();
+    delete this->end_null_;
+    delete this->begin_null_;
+  }
+
+  Multiset& operator=(Multiset&& other) {
+    this->clear();
+    this->swap(other);
+    return *this;
+  }
+
+  Multiset& operator=(const Multiset& other) {
+    if (this != &other) {
+      this->clear();
+      for (auto it = other.cbegin(); it != other.cend(); ++it)
+        this->insert(*it);
+    }
+    return *this;
+  }
+
+  iterator insert(const value_type& value) { return this->InsertEqual(value); }
+
+  template <class... Args>
+  iterator emplace(Args&&... args) {
+    return this->InsertEqual(value_type(std::forward<Args>(args)...));
+  }
+
+  size_type erase(const Key& key) {
+    size_type count = 0;
+    iterator it = lower_bound(key);
+    while (it != this->end() && this->comparator_.Equals(*it, key)) {
+      iterator tmp = it + 1;
+      erase(it);
+      it = tmp;
+      ++count;
+    }
+    return count;
+  }
+
+  void merge(Multiset& other) {
+    auto it = other.begin();
+    while (it != other.end()) {
+      auto tmp = it + 1;
+      other.DeleteOrExtract(it, false);
+      this->InsertEqual(*it, it.node());
+      it = tmp;
+    }
+    this->ShareBlocks(other);
+  }
+
+  size_type count(const Key& key) {
+    size_type count = 0;
+    for (iterator it = lower_bound(key);
+         it != this->end() && this->comparator_.Equals(*it, key); ++it)
+      ++count;
+    return count;
+  }
+
+  iterator find(const Key& key) {
+    iterator it = lower_bound(key);
+    if (it != this->end() && this->comparator_.NotEquals(*it, key))
+      it = this->end();
+    return it;
+  }
+
+  bool contains(const Key& key) { return find(key) != this->end(); }
+
+  std::pair<iterator, iterator> equal_range(const Key& key) {
+    return std::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+  }
+
+  iterator lower_bound(const Key& key) {
+    return iterator(this->LowerBound(key));
+  }
+
+  iterator upper_bound(const Key& key) {
+    return iterator(this->UpperBound(key));
+  }
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_MULTISET_H_
@@ -0,0 +1,125 @@
+#ifndef CONTAINERS_SRC_S21_NODE_ARENA_H_
+#define CONTAINERS_SRC_S21_NODE_ARENA_H_
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+#include "s21_vector.h"
+
+namespace s21 {
+namespace arena {
+// A contiguous run of nodes created by compact(). merge, splice, join and
+// split move nodes between containers, so several containers may hold
+// nodes of one block: the memory goes with its last live node, the record
+// with the last container that lists it. Containers sharing a block may be
+// used from different threads, hence the atomic counters.
+struct Block {
+  uintptr_t begin_;
+  uintptr_t end_;
+  std::atomic<size_t> live_;
+  std::atomic<size_t> holders_{1};
+
+  Block(void *memory, size_t bytes, size_t nodes)
+      : begin_((uintptr_t)memory),
+        end_((uintptr_t)memory + bytes),
+        live_(nodes) {}
+};
+
+// Live blocks in the process; only changes when a block is created or
+// released.
+inline std::atomic<size_t> &BlockCount() {
+  static std::atomic<size_t> count{0};
+  return count;
+}
+
+inline size_t LiveBlocks() {
+  return BlockCount().load(std::memory_order_relaxed);
+}
+
+// The blocks a container may hold nodes from. Empty unless the container
+// compacted or took nodes from one that did, so for most containers
+// freeing a node costs one size check; otherwise a scan of a few ranges,
+// with no lock. Whenever nodes move to another container, the receiver
+// must Share() the sender's blocks.
+class Blocks {
+ public:
+  Blocks() {}
+  Blocks(const Blocks &) = delete;
+  Blocks &operator=(const Blocks &) = delete;
+
+  ~Blocks() { clear(); }
+
+  // Raw storage for n nodes; each slot must be constructed with placement
+  // new and eventually passed to Free.
+  template <class Node>
+  Node *Allocate(size_t n) {
+    void *memory = ::operator new(sizeof(Node) * n);
+    list_.push_back(new Block(memory, sizeof(Node) * n, n));
+    BlockCount().fetch_add(1, std::memory_order_relaxed);
+    return (Node *)memory;
+  }
+
+  // Destroys a node whether it came from new or from a listed block.
+  template <class Node>
+  void Free(Node *node) {
+    node->~Node();
+    uintptr_t address = (uintptr_t)node;
+    for (size_t i = 0; i < list_.size(); ++i) {
+      Block *block = list_[i];
+      // A block released through another container may have been reused
+      // for plain nodes; its range no longer means anything.
+      if (!block->live_.load(std::memory_order_acquire)) {
+        Drop(i--);
+        continue;
+      }
+      if (address < block->begin_ || address >= block->end_) continue;
+      if (block->live_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        ::operator delete((void *)block->begin_);
+        BlockCount().fetch_sub(1, std::memory_order_relaxed);
+        Drop(i);
+      }
+      return;
+    }
+    ::operator delete(node);
+  }
+
+  // Lists the live blocks of other too, after nodes moved from it.
+  void Share(const Blocks &other) {
+    for (size_t i = 0; i < other.list_.size(); ++i) {
+      Block *block = other.list_[i];
+      if (block->live_.load(std::memory_order_acquire) && !Holds(block)) {
+        block->holders_.fetch_add(1, std::memory_order_relaxed);
+        list_.push_back(block);
+      }
+    }
+  }
+
+  // Forgets every block; for containers left without nodes.
+  void clear() {
+    while (!list_.empty()) Drop(list_.size() - 1);
+  }
+
+  void swap(Blocks &other) { list_.swap(other.list_); }
+
+ private:
+  Vector<Block *> list_;
+
+  bool Holds(const Block *block) const {
+    for (size_t i = 0; i < list_.size(); ++i)
+      if (list_[i] == block) return true;
+    return false;
+  }
+
+  void Drop(size_t i) {
+    Block *block = list_[i];
+    list_[i] = list_[list_.size() - 1];
+    list_.pop_back();
+    if (block->holders_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      delete block;
+  }
+};
+}  // namespace arena
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_NODE_ARENA_H_
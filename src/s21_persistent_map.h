@@ -0,0 +1,310 @@
+#ifndef CONTAINERS_SRC_S21_PERSISTENT_MAP_H_
+#define CONTAINERS_SRC_S21_PERSISTENT_MAP_H_
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_comparators.h"
+#include "s21_instrumentation.h"
+#include "s21_vector.h"
+
+namespace s21 {
+// Ordered map whose nodes are never modified once built. An update copies the
+// O(log n) nodes on the path to the key and shares everything else, so
+// snapshot() (or a copy) only bumps the root's reference count. The tree is a
+// treap, which keeps paths logarithmic with random priorities.
+//
+// A map handle must not be updated and copied at the same time, but every
+// copy can be read on its own thread without locks while the original keeps
+// changing: shared nodes are immutable and their counts are atomic.
+template <class Key, class T, class Compare = SingleComparator<Key>>
+class PersistentMap {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using key_compare = Compare;
+  using const_reference = const value_type &;
+  using size_type = size_t;
+
+ private:
+  struct Node {
+    Node(const value_type &value, uint32_t priority, const Node *left,
+         const Node *right)
+        : value_(value), priority_(priority), left_(left), right_(right) {}
+
+    mutable std::atomic<size_t> refs_{1};
+    value_type value_;
+    uint32_t priority_;
+    const Node *left_;
+    const Node *right_;
+  };
+
+ public:
+  // Walks the tree with an explicit stack, since shared nodes cannot point
+  // back to a parent. The top of the stack is the current node; below it are
+  // the ancestors still to be visited.
+  class ConstIterator {
+   public:
+    ConstIterator() {}
+
+    const_reference operator*() const { return path_.back()->value_; }
+    const value_type *operator->() const { return &path_.back()->value_; }
+
+    ConstIterator &operator++() {
+      const Node *node = path_.back()->right_;
+      path_.pop_back();
+      PushLeft(node);
+      return *this;
+    }
+
+    ConstIterator operator++(int) {
+      ConstIterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const ConstIterator &other) const {
+      if (path_.size() != other.path_.size()) return false;
+      return path_.empty() || path_.back() == other.path_.back();
+    }
+
+    bool operator!=(const ConstIterator &other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class PersistentMap;
+    Vector<const Node *> path_;
+
+    void PushLeft(const Node *node) {
+      for (; node; node = node->left_) path_.push_back(node);
+    }
+  };
+
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+
+  PersistentMap() {}
+
+  PersistentMap(std::initializer_list<std::pair<Key, T>> const &items) {
+    for (auto it = items.begin(); it != items.end(); ++it)
+      insert(it->first, it->second);
+  }
+
+  PersistentMap(const PersistentMap &other)
+      : root_(Retain(other.root_)),
+        size_(other.size_),
+        state_(other.state_) {}
+
+  PersistentMap(PersistentMap &&other) { swap(other); }
+
+  ~PersistentMap() { Release(root_); }
+
+  PersistentMap &operator=(const PersistentMap &other) {
+    PersistentMap copy(other);
+    swap(copy);
+    return *this;
+  }
+
+  PersistentMap &operator=(PersistentMap &&other) {
+    swap(other);
+    return *this;
+  }
+
+  // O(1): the snapshot shares every node with this map.
+  PersistentMap snapshot() const { return *this; }
+
+  const_iterator begin() const {
+    const_iterator it;
+    it.PushLeft(root_);
+    return it;
+  }
+
+  const_iterator end() const { return const_iterator(); }
+
+  bool empty() const { return !size_; }
+  size_type size() const { return size_; }
+
+  const_iterator find(const Key &key) const {
+    const_iterator it;
+    const Node *node = root_;
+    while (node) {
+      if (comparator_.LessThan(key, node->value_.first)) {
+        it.path_.push_back(node);
+        node = node->left_;
+      } else if (comparator_.GreaterThan(key, node->value_.first)) {
+        node = node->right_;
+      } else {
+        it.path_.push_back(node);
+        return it;
+      }
+    }
+    return end();
+  }
+
+  bool contains(const Key &key) const { return Search(key) != nullptr; }
+
+  const T &at(const Key &key) const {
+    const Node *node = Search(key);
+    if (!node) throw std::out_of_range("s21::PersistentMap::at");
+    return node->value_.second;
+  }
+
+  // Returns false and leaves the map unchanged if key is already present.
+  bool insert(const Key &key, const T &obj) {
+    if (Search(key)) return false;
+    Replace(Insert(root_, value_type(key, obj), NextPriority()));
+    ++size_;
+    return true;
+  }
+
+  // Returns true if key was inserted rather than assigned.
+  bool insert_or_assign(const Key &key, const T &obj) {
+    if (!Search(key)) return insert(key, obj);
+    Replace(Assign(root_, value_type(key, obj)));
+    return false;
+  }
+
+  size_type erase(const Key &key) {
+    if (!Search(key)) return 0;
+    Replace(Erase(root_, key));
+    --size_;
+    return 1;
+  }
+
+  void clear() {
+    Replace(nullptr);
+    size_ = 0;
+  }
+
+  void swap(PersistentMap &other) {
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    std::swap(state_, other.state_);
+  }
+
+ private:
+  const Node *root_ = nullptr;
+  size_type size_ = 0;
+  uint32_t state_ = 2463534242u;
+  key_compare comparator_;
+
+  uint32_t NextPriority() {
+    state_ ^= state_ << 13;
+    state_ ^= state_ >> 17;
+    state_ ^= state_ << 5;
+    return state_;
+  }
+
+  const Node *Search(const Key &key) const {
+    const Node *node = root_;
+    while (node) {
+      if (comparator_.LessThan(key, node->value_.first))
+        node = node->left_;
+      else if (comparator_.GreaterThan(key, node->value_.first))
+        node = node->right_;
+      else
+        break;
+    }
+    return node;
+  }
+
+  void Replace(const Node *root) {
+    Release(root_);
+    root_ = root;
+  }
+
+  // The functions below take borrowed nodes and return a new subtree that the
+  // caller owns. Subtrees reused as they are get one more reference.
+  static const Node *Retain(const Node *node) {
+    if (node) node->refs_.fetch_add(1, std::memory_order_relaxed);
+    return node;
+  }
+
+  static void Release(const Node *node) {
+    while (node && node->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      const Node *right = node->right_;
+      Release(node->left_);
+      delete node;
+      S21_COUNT(tree_node_frees, 1);
+      node = right;
+    }
+  }
+
+  static const Node *Make(const value_type &value, uint32_t priority,
+                          const Node *left, const Node *right) {
+    S21_COUNT(tree_node_allocations, 1);
+    return new Node(value, priority, left, right);
+  }
+
+  // key must be absent.
+  const Node *Insert(const Node *node, const value_type &value,
+                     uint32_t priority) {
+    if (!node) return Make(value, priority, nullptr, nullptr);
+    if (priority > node->priority_) {
+      std::pair<const Node *, const Node *> halves = Split(node, value.first);
+      return Make(value, priority, halves.first, halves.second);
+    }
+    if (comparator_.LessThan(value.first, node->value_.first))
+      return Make(node->value_, node->priority_,
+                  Insert(node->left_, value, priority), Retain(node->right_));
+    return Make(node->value_, node->priority_, Retain(node->left_),
+                Insert(node->right_, value, priority));
+  }
+
+  // Keys less than and greater than key, which must be absent.
+  std::pair<const Node *, const Node *> Split(const Node *node,
+                                              const Key &key) {
+    if (!node) return {nullptr, nullptr};
+    if (comparator_.LessThan(node->value_.first, key)) {
+      std::pair<const Node *, const Node *> halves = Split(node->right_, key);
+      return {Make(node->value_, node->priority_, Retain(node->left_),
+                   halves.first),
+              halves.second};
+    }
+    std::pair<const Node *, const Node *> halves = Split(node->left_, key);
+    return {halves.first, Make(node->value_, node->priority_, halves.second,
+                               Retain(node->right_))};
+  }
+
+  // key must be present.
+  const Node *Assign(const Node *node, const value_type &value) {
+    if (comparator_.LessThan(value.first, node->value_.first))
+      return Make(node->value_, node->priority_, Assign(node->left_, value),
+                  Retain(node->right_));
+    if (comparator_.GreaterThan(value.first, node->value_.first))
+      return Make(node->value_, node->priority_, Retain(node->left_),
+                  Assign(node->right_, value));
+    return Make(value, node->priority_, Retain(node->left_),
+                Retain(node->right_));
+  }
+
+  // key must be present.
+  const Node *Erase(const Node *node, const Key &key) {
+    if (comparator_.LessThan(key, node->value_.first))
+      return Make(node->value_, node->priority_, Erase(node->left_, key),
+                  Retain(node->right_));
+    if (comparator_.GreaterThan(key, node->value_.first))
+      return Make(node->value_, node->priority_, Retain(node->left_),
+                  Erase(node->right_, key));
+    return Merge(node->left_, node->right_);
+  }
+
+  // Every key of lower is less than every key of upper.
+  const Node *Merge(const Node *lower, const Node *upper) {
+    if (!lower) return Retain(upper);
+    if (!upper) return Retain(lower);
+    if (lower->priority_ > upper->priority_)
+      return Make(lower->value_, lower->priority_, Retain(lower->left_),
+                  Merge(lower->right_, upper));
+    return Make(upper->value_, upper->priority_, Merge(lower, upper->left_),
+                Retain(upper->right_));
+  }
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_PERSISTENT_MAP_H_
@@ -0,0 +1,171 @@
+#ifndef CONTAINERS_SRC_S21_PRIORITY_QUEUE_H_
+#define CONTAINERS_SRC_S21_PRIORITY_QUEUE_H_
+
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "s21_comparators.h"
+#include "s21_vector.h"
+
+namespace s21 {
+// d-ary max-heap: top() is the element for which no other compares greater.
+// Wider heaps are shallower, so pop touches fewer cache lines.
+template <typename T, class container_type = Vector<T>,
+          class Compare = SingleComparator<T>, size_t Arity = 4>
+class PriorityQueue {
+  static_assert(Arity >= 2, "s21::PriorityQueue: arity must be at least 2");
+
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+
+  PriorityQueue() : container_(new container_type) {}
+
+  PriorityQueue(std::initializer_list<value_type> const& items)
+      : PriorityQueue(items.begin(), items.end()) {}
+
+  template <class InputIt>
+  PriorityQueue(InputIt first, InputIt last)
+      : container_(new container_type) {
+    for (; first != last; ++first) container_->push_back(*first);
+    this->Heapify();
+  }
+
+  PriorityQueue(const PriorityQueue& q) : container_(new container_type) {
+    container_->reserve(q.size());
+    for (size_type i = 0; i < q.size(); ++i)
+      container_->push_back(q.container_->data()[i]);
+  }
+
+  PriorityQueue(PriorityQueue&& q) : container_(new container_type) {
+    this->swap(q);
+  }
+
+  ~PriorityQueue() { delete container_; }
+
+  PriorityQueue& operator=(const PriorityQueue& q) {
+    if (this != &q) {
+      PriorityQueue copy(q);
+      this->swap(copy);
+    }
+    return *this;
+  }
+
+  PriorityQueue& operator=(PriorityQueue&& q) {
+    this->swap(q);
+    return *this;
+  }
+
+  const_reference top() const { return container_->data()[0]; }
+  bool empty() const { return container_->empty(); }
+  size_type size() const { return container_->size(); }
+
+  void push(const_reference value) {
+    container_->push_back(value);
+    this->SiftUp(container_->size() - 1);
+  }
+
+  template <class... Args>
+  void emplace(Args&&... args) {
+    this->push(value_type(std::forward<Args>(args)...));
+  }
+
+  // Appends the range; rebuilds the heap in O(n) when that is cheaper than
+  // sifting every new element up.
+  template <class InputIt>
+  void push_range(InputIt first, InputIt last) {
+    size_type old_size = container_->size();
+    for (; first != last; ++first) container_->push_back(*first);
+    size_type added = container_->size() - old_size;
+    if (added > old_size / 2) {
+      this->Heapify();
+    } else {
+      for (size_type i = old_size; i < container_->size(); ++i)
+        this->SiftUp(i);
+    }
+  }
+
+  // The hole left by top() is walked down to a leaf without comparing against
+  // the displaced last element, which then sifts up from there; it almost
+  // always belongs near the bottom, so this saves a comparison per level.
+  void pop() {
+    value_type* heap = container_->data();
+    size_type last = container_->size() - 1;
+    if (last) {
+      value_type value = std::move(heap[last]);
+      size_type pos = 0;
+      for (size_type child; (child = pos * Arity + 1) < last;) {
+        size_type best = this->BestChild(heap, child, last);
+        heap[pos] = std::move(heap[best]);
+        pos = best;
+      }
+      heap[pos] = std::move(value);
+      this->SiftUp(pos);
+    }
+    container_->pop_back();
+  }
+
+  void swap(PriorityQueue& other) {
+    std::swap(container_, other.container_);
+    std::swap(comparator_, other.comparator_);
+  }
+
+ private:
+  container_type* container_;
+  Compare comparator_;
+
+  void SiftUp(size_type pos) {
+    value_type* heap = container_->data();
+    value_type value = std::move(heap[pos]);
+    while (pos) {
+      size_type parent = (pos - 1) / Arity;
+      if (!comparator_.LessThan(heap[parent], value)) break;
+      heap[pos] = std::move(heap[parent]);
+      pos = parent;
+    }
+    heap[pos] = std::move(value);
+  }
+
+  // Index of the greatest of the children starting at first. The selection is
+  // written without branches: the comparisons are unpredictable on random
+  // keys, and a full group has a fixed trip count the compiler unrolls.
+  size_type BestChild(const value_type* heap, size_type first,
+                      size_type n) const {
+    size_type best = first;
+    if (first + Arity <= n) {
+      for (size_type i = 1; i < Arity; ++i)
+        best = comparator_.LessThan(heap[best], heap[first + i]) ? first + i
+                                                                  : best;
+    } else {
+      for (size_type i = first + 1; i < n; ++i)
+        best = comparator_.LessThan(heap[best], heap[i]) ? i : best;
+    }
+    return best;
+  }
+
+  // Moves the hole at pos down to where value belongs among the first n
+  // elements.
+  void SiftDown(size_type pos, value_type value, size_type n) {
+    value_type* heap = container_->data();
+    for (size_type child; (child = pos * Arity + 1) < n;) {
+      size_type best = this->BestChild(heap, child, n);
+      if (!comparator_.LessThan(value, heap[best])) break;
+      heap[pos] = std::move(heap[best]);
+      pos = best;
+    }
+    heap[pos] = std::move(value);
+  }
+
+  void Heapify() {
+    size_type n = container_->size();
+    if (n < 2) return;
+    value_type* heap = container_->data();
+    for (size_type i = (n - 2) / Arity + 1; i-- > 0;)
+      this->SiftDown(i, std::move(heap[i]), n);
+  }
+};
+}  // namespace s21
+#endif  // CONTAINERS_SRC_S21_PRIORITY_QUEUE_H_
@@ -4,23 +4,29 @@
 #include <iostream>
 
 #include "s21_btree.h"
+#include "s21_compact_btree.h"
+#include "s21_frozen.h"
 
 namespace s21 {
-template <typename Key, class Compare = s21::SingleComparator<Key>>
+template <typename Key, class Compare = s21::SingleComparator<Key>,
+          class Nodes = PointerNodes>
 class Set : public BTree<Key, Compare> {
  public:
   using key_type = Key;
-  using value_type = typename BTree<Key>::value_type;
-  using reference = typename BTree<Key>::value_type&;
-  using const_reference = const typename BTree<Key>::value_type&;
+  using value_type = typename BTree<Key, Compare>::value_type;
+  using reference = typename BTree<Key, Compare>::value_type&;
+  using const_reference = const typename BTree<Key, Compare>::value_type&;
   using size_type = size_t;
-  using iterator = typename BTree<Key>::Iterator;
-  using const_iterator = typename BTree<Key>::ConstIterator;
+  using iterator = typename BTree<Key, Compare>::Iterator;
+  using const_iterator = typename BTree<Key, Compare>::ConstIterator;
   using tree_node = typename BTree<Key, Compare>::Node;
 
+  using BTree<Key, Compare>::erase;
+
   Set() {
-    this->end_null_ = new tree_node(0);
-    this->begin_null_ = new tree_node(0, nullptr, nullptr, this->end_null_);
+    this->end_null_ = new tree_node(Key());
+    this->begin_null_ =
+        new tree_node(Key(), nullptr, nullptr, this->end_null_);
     this->end_null_->parent_ = this->begin_null_;
   }
 
@@ -56,6 +62,33 @@ class Set : public BTree<Key, Compare> {
     return this->InsertOrPaste(value);
   }
 
+  iterator insert(iterator hint, const value_type& value) {
+    return this->InsertWithHint(hint, value).first;
+  }
+
+  template <class... Args>
+  iterator emplace_hint(iterator hint, Args&&... args) {
+    return this->InsertWithHint(hint, value_type(std::forward<Args>(args)...))
+        .first;
+  }
+
+  void erase(iterator first, iterator last) {
+    if (first != last)
+      this->EraseBetween(*first, last == this->end() ? nullptr : &*last);
+  }
+
+  size_type erase_range(const Key& lo, const Key& hi) {
+    return this->EraseBetween(lo, &hi);
+  }
+
+  Set split(const Key& key) {
+    Set upper;
+    this->SplitTree(key, upper);
+    return upper;
+  }
+
+  void join(Set& other) { this->JoinTree(other); }
+
   void merge(Set& other) {
     auto it = other.begin();
     while (it != other.end()) {
@@ -66,25 +99,169 @@ class Set : public BTree<Key, Compare> {
       }
       it = tmp;
     }
+    this->ShareBlocks(other);
+  }
+
+  FrozenSet<Key, Compare> freeze() {
+    return FrozenSet<Key, Compare>(this->begin(), this->size());
+  }
+
+  // Writes the keys in order to a snapshot file; see s21_snapshot.h.
+  void save(const std::string& path) {
+    snapshot::Writer writer(path);
+    writer.Begin(snapshot::kSet, snapshot::SizeOf<Key>(), 0, this->size());
+    for (auto it = this->begin(); it != this->end(); ++it) writer.Write(*it);
+    writer.Close();
+  }
+
+  // Sorted keys all take the append fast path, so the tree is built as one
+  // right spine in linear time and then rebalanced.
+  void load(const std::string& path) {
+    snapshot::Reader reader(path);
+    uint64_t n = reader.Begin(snapshot::kSet, snapshot::SizeOf<Key>(), 0);
+    Set loaded;
+    Key key;
+    for (uint64_t i = 0; i < n; ++i) {
+      reader.Read(key);
+      loaded.InsertOrPaste(key);
+    }
+    loaded.rebalance();
+    this->InheritBloom(loaded);
+    this->clear();
+    this->swap(loaded);
+  }
+
+  iterator find(const Key& key) { return Find(key); }
+  bool contains(const Key& key) { return Find(key) != this->end(); }
+  size_type count(const Key& key) { return contains(key); }
+  iterator lower_bound(const Key& key) {
+    return iterator(this->LowerBound(key));
+  }
+
+  // Lookups by text, such as a std::string_view for std::string keys,
+  // without building a Key; see IsKeyProbe.
+  template <class K, class C = Compare, class = typename C::is_transparent,
+            class = EnableIfKeyProbe<Key, K>>
+  iterator find(const K& key) {
+    return Find(key);
+  }
+  template <class K, class C = Compare, class = typename C::is_transparent,
+            class = EnableIfKeyProbe<Key, K>>
+  bool contains(const K& key) {
+    return Find(key) != this->end();
+  }
+  template <class K, class C = Compare, class = typename C::is_transparent,
+            class = EnableIfKeyProbe<Key, K>>
+  size_type count(const K& key) {
+    return contains(key);
+  }
+  template <class K, class C = Compare, class = typename C::is_transparent,
+            class = EnableIfKeyProbe<Key, K>>
+  iterator lower_bound(const K& key) {
+    return iterator(this->LowerBound(key));
+  }
+
+  // Batched find: out[i] is the iterator to keys[i], or end(). The
+  // descents of the batch are interleaved; see BTree::SearchMany.
+  void find_many(const Vector<Key>& keys, Vector<iterator>& out) {
+    Vector<iterator> found(keys.size());
+    this->SearchMany(keys.data(), keys.size(), KeyLess(this),
+                     [&](size_type i, tree_node* node) {
+                       found[i] = node ? iterator(node) : this->end();
+                     });
+    out.swap(found);
+  }
+
+  // Batched contains; returns how many of keys are present.
+  size_type contains_many(const Vector<Key>& keys, Vector<bool>& out) {
+    Vector<bool> found(keys.size());
+    size_type hits = 0;
+    this->SearchMany(keys.data(), keys.size(), KeyLess(this),
+                     [&](size_type i, tree_node* node) {
+                       found[i] = node;
+                       hits += (bool)node;
+                     });
+    out.swap(found);
+    return hits;
+  }
+
+ private:
+  template <class K>
+  iterator Find(const K& key) {
+    if (this->BloomRejects(key)) return this->end();
+    tree_node* node = this->FindNode(key);
+    return node ? iterator(node) : this->end();
+  }
+
+  struct KeyLess {
+    const Set* set_;
+
+    explicit KeyLess(const Set* set) : set_(set) {}
+    bool operator()(const Key& a, const Key& b) const {
+      return set_->comparator_.LessThan(a, b);
+    }
+  };
+};
+
+template <typename Key, class Compare>
+class Set<Key, Compare, CompactNodes> : public CompactBTree<Key, Compare> {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = size_t;
+  using iterator = typename CompactBTree<Key, Compare>::Iterator;
+  using const_iterator = typename CompactBTree<Key, Compare>::ConstIterator;
+
+  Set() {}
+
+  Set(std::initializer_list<value_type> const& items) {
+    for (auto it = items.begin(); it != items.end(); ++it) this->insert(*it);
+  }
+
+  Set(const Set& other) {
+    for (auto it = other.cbegin(); it != other.cend(); ++it) this->insert(*it);
+  }
+
+  Set(Set&& other) { this->swap(other); }
+
+  Set& operator=(Set&& other) {
+    this->clear();
+    this->swap(other);
+    return *this;
+  }
+
+  Set& operator=(const Set& other) {
+    if (this != &other) {
+      this->clear();
+      for (auto it = other.cbegin(); it != other.cend(); ++it)
+        this->insert(*it);
+    }
+    return *this;
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return this->InsertOrPaste(value);
   }
 
-  iterator find(const Key& key) {
-    auto it = this->end();
-    if (this->contains(key)) {
-      it = this->begin();
-      while (*it != key) ++it;
+  void merge(Set& other) {
+    auto it = other.begin();
+    while (it != other.end()) {
+      auto tmp = it + 1;
+      if (this->insert(*it).second) other.erase(it);
+      it = tmp;
     }
-    return it;
   }
 
-  bool contains(const Key& key) {
-    tree_node* tmp = this->root_;
-    bool flag = false;
-    this->Search(key, tmp);
-    if (tmp && tmp != this->end_null_ && tmp != this->begin_null_ &&
-        tmp->data_ == key)
-      flag = true;
-    return flag;
+  FrozenSet<Key, Compare> freeze() {
+    return FrozenSet<Key, Compare>(this->begin(), this->size());
+  }
+
+  iterator find(const Key& key) { return iterator(this, this->Search(key)); }
+
+  bool contains(const Key& key) const {
+    return this->Search(key) != this->kNull;
   }
 };
 }  // namespace s21
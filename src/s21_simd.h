@@ -0,0 +1,459 @@
+#ifndef CONTAINERS_SRC_S21_SIMD_H_
+#define CONTAINERS_SRC_S21_SIMD_H_
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_vector.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define S21_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+namespace simd {
+enum class Level { kScalar, kSse2, kAvx2 };
+
+inline Level DetectLevel() {
+#ifdef S21_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return Level::kAvx2;
+  if (__builtin_cpu_supports("sse2")) return Level::kSse2;
+#endif
+  return Level::kScalar;
+}
+
+inline Level ActiveLevel() {
+  static const Level level = DetectLevel();
+  return level;
+}
+
+template <class T>
+using SumType = typename std::conditional<
+    std::is_floating_point<T>::value, double,
+    typename std::conditional<std::is_signed<T>::value, int64_t,
+                              uint64_t>::type>::type;
+
+template <class T>
+size_t FindScalar(const T *data, size_t n, T value) {
+  size_t i = 0;
+  while (i < n && !(data[i] == value)) ++i;
+  return i;
+}
+
+template <class T>
+size_t CountScalar(const T *data, size_t n, T value) {
+  size_t count = 0;
+  for (size_t i = 0; i < n; ++i) count += data[i] == value;
+  return count;
+}
+
+template <bool kMax, class T>
+T MinMaxScalar(const T *data, size_t n) {
+  T result = data[0];
+  for (size_t i = 1; i < n; ++i)
+    if (kMax ? result < data[i] : data[i] < result) result = data[i];
+  return result;
+}
+
+template <class T>
+SumType<T> SumScalar(const T *data, size_t n) {
+  SumType<T> sum = 0;
+  for (size_t i = 0; i < n; ++i) sum += data[i];
+  return sum;
+}
+
+#ifdef S21_SIMD_X86
+// Counters are kept in 32-bit lanes, so they are flushed at least this often.
+constexpr size_t kCountFlush = size_t(1) << 24;
+
+__attribute__((target("sse2"))) inline size_t FindSse2(const int32_t *data,
+                                                       size_t n,
+                                                       int32_t value) {
+  const __m128i needle = _mm_set1_epi32(value);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    int mask =
+        _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, needle)));
+    if (mask) return i + __builtin_ctz(mask);
+  }
+  return i + FindScalar(data + i, n - i, value);
+}
+
+__attribute__((target("sse2"))) inline size_t FindSse2(const float *data,
+                                                       size_t n, float value) {
+  const __m128 needle = _mm_set1_ps(value);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), needle));
+    if (mask) return i + __builtin_ctz(mask);
+  }
+  return i + FindScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2"))) inline size_t FindAvx2(const int32_t *data,
+                                                       size_t n,
+                                                       int32_t value) {
+  const __m256i needle = _mm256_set1_epi32(value);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    int mask = _mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle)));
+    if (mask) return i + __builtin_ctz(mask);
+  }
+  return i + FindScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2"))) inline size_t FindAvx2(const float *data,
+                                                       size_t n, float value) {
+  const __m256 needle = _mm256_set1_ps(value);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    int mask = _mm256_movemask_ps(
+        _mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ));
+    if (mask) return i + __builtin_ctz(mask);
+  }
+  return i + FindScalar(data + i, n - i, value);
+}
+
+__attribute__((target("sse2"))) inline size_t CountSse2(const int32_t *data,
+                                                        size_t n,
+                                                        int32_t value) {
+  const __m128i needle = _mm_set1_epi32(value);
+  size_t count = 0;
+  size_t i = 0;
+  while (i + 4 <= n) {
+    __m128i lanes = _mm_setzero_si128();
+    size_t stop = n - i > kCountFlush ? i + kCountFlush : n;
+    for (; i + 4 <= stop; i += 4) {
+      __m128i block =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+      lanes = _mm_sub_epi32(lanes, _mm_cmpeq_epi32(block, needle));
+    }
+    alignas(16) uint32_t parts[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(parts), lanes);
+    count += size_t(parts[0]) + parts[1] + parts[2] + parts[3];
+  }
+  return count + CountScalar(data + i, n - i, value);
+}
+
+__attribute__((target("sse2"))) inline size_t CountSse2(const float *data,
+                                                        size_t n, float value) {
+  const __m128 needle = _mm_set1_ps(value);
+  size_t count = 0;
+  size_t i = 0;
+  while (i + 4 <= n) {
+    __m128i lanes = _mm_setzero_si128();
+    size_t stop = n - i > kCountFlush ? i + kCountFlush : n;
+    for (; i + 4 <= stop; i += 4) {
+      __m128 equal = _mm_cmpeq_ps(_mm_loadu_ps(data + i), needle);
+      lanes = _mm_sub_epi32(lanes, _mm_castps_si128(equal));
+    }
+    alignas(16) uint32_t parts[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(parts), lanes);
+    count += size_t(parts[0]) + parts[1] + parts[2] + parts[3];
+  }
+  return count + CountScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2"))) inline size_t CountAvx2(const int32_t *data,
+                                                        size_t n,
+                                                        int32_t value) {
+  const __m256i needle = _mm256_set1_epi32(value);
+  size_t count = 0;
+  size_t i = 0;
+  while (i + 8 <= n) {
+    __m256i lanes = _mm256_setzero_si256();
+    size_t stop = n - i > kCountFlush ? i + kCountFlush : n;
+    for (; i + 8 <= stop; i += 8) {
+      __m256i block =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+      lanes = _mm256_sub_epi32(lanes, _mm256_cmpeq_epi32(block, needle));
+    }
+    alignas(32) uint32_t parts[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(parts), lanes);
+    for (int j = 0; j < 8; ++j) count += parts[j];
+  }
+  return count + CountScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2"))) inline size_t CountAvx2(const float *data,
+                                                        size_t n, float value) {
+  const __m256 needle = _mm256_set1_ps(value);
+  size_t count = 0;
+  size_t i = 0;
+  while (i + 8 <= n) {
+    __m256i lanes = _mm256_setzero_si256();
+    size_t stop = n - i > kCountFlush ? i + kCountFlush : n;
+    for (; i + 8 <= stop; i += 8) {
+      __m256 equal =
+          _mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ);
+      lanes = _mm256_sub_epi32(lanes, _mm256_castps_si256(equal));
+    }
+    alignas(32) uint32_t parts[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(parts), lanes);
+    for (int j = 0; j < 8; ++j) count += parts[j];
+  }
+  return count + CountScalar(data + i, n - i, value);
+}
+
+template <bool kMax>
+__attribute__((target("sse2"))) inline int32_t MinMaxSse2(const int32_t *data,
+                                                          size_t n) {
+  int32_t result = data[0];
+  size_t i = 0;
+  if (n >= 4) {
+    __m128i best = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    for (i = 4; i + 4 <= n; i += 4) {
+      __m128i block =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+      __m128i take = kMax ? _mm_cmpgt_epi32(block, best)
+                          : _mm_cmplt_epi32(block, best);
+      best = _mm_or_si128(_mm_and_si128(take, block),
+                          _mm_andnot_si128(take, best));
+    }
+    alignas(16) int32_t parts[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(parts), best);
+    result = MinMaxScalar<kMax>(parts, 4);
+  }
+  for (; i < n; ++i)
+    if (kMax ? result < data[i] : data[i] < result) result = data[i];
+  return result;
+}
+
+template <bool kMax>
+__attribute__((target("sse2"))) inline float MinMaxSse2(const float *data,
+                                                        size_t n) {
+  float result = data[0];
+  size_t i = 0;
+  if (n >= 4) {
+    __m128 best = _mm_loadu_ps(data);
+    for (i = 4; i + 4 <= n; i += 4) {
+      __m128 block = _mm_loadu_ps(data + i);
+      best = kMax ? _mm_max_ps(block, best) : _mm_min_ps(block, best);
+    }
+    alignas(16) float parts[4];
+    _mm_store_ps(parts, best);
+    result = MinMaxScalar<kMax>(parts, 4);
+  }
+  for (; i < n; ++i)
+    if (kMax ? result < data[i] : data[i] < result) result = data[i];
+  return result;
+}
+
+template <bool kMax>
+__attribute__((target("avx2"))) inline int32_t MinMaxAvx2(const int32_t *data,
+                                                          size_t n) {
+  int32_t result = data[0];
+  size_t i = 0;
+  if (n >= 8) {
+    __m256i best =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+    for (i = 8; i + 8 <= n; i += 8) {
+      __m256i block =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+      best = kMax ? _mm256_max_epi32(block, best)
+                  : _mm256_min_epi32(block, best);
+    }
+    alignas(32) int32_t parts[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(parts), best);
+    result = MinMaxScalar<kMax>(parts, 8);
+  }
+  for (; i < n; ++i)
+    if (kMax ? result < data[i] : data[i] < result) result = data[i];
+  return result;
+}
+
+template <bool kMax>
+__attribute__((target("avx2"))) inline float MinMaxAvx2(const float *data,
+                                                        size_t n) {
+  float result = data[0];
+  size_t i = 0;
+  if (n >= 8) {
+    __m256 best = _mm256_loadu_ps(data);
+    for (i = 8; i + 8 <= n; i += 8) {
+      __m256 block = _mm256_loadu_ps(data + i);
+      best = kMax ? _mm256_max_ps(block, best) : _mm256_min_ps(block, best);
+    }
+    alignas(32) float parts[8];
+    _mm256_store_ps(parts, best);
+    result = MinMaxScalar<kMax>(parts, 8);
+  }
+  for (; i < n; ++i)
+    if (kMax ? result < data[i] : data[i] < result) result = data[i];
+  return result;
+}
+
+__attribute__((target("sse2"))) inline int64_t SumSse2(const int32_t *data,
+                                                       size_t n) {
+  __m128i low = _mm_setzero_si128();
+  __m128i high = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    __m128i sign = _mm_cmpgt_epi32(_mm_setzero_si128(), block);
+    low = _mm_add_epi64(low, _mm_unpacklo_epi32(block, sign));
+    high = _mm_add_epi64(high, _mm_unpackhi_epi32(block, sign));
+  }
+  alignas(16) int64_t parts[2];
+  _mm_store_si128(reinterpret_cast<__m128i *>(parts),
+                  _mm_add_epi64(low, high));
+  return parts[0] + parts[1] + SumScalar(data + i, n - i);
+}
+
+__attribute__((target("sse2"))) inline double SumSse2(const float *data,
+                                                      size_t n) {
+  __m128d low = _mm_setzero_pd();
+  __m128d high = _mm_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 block = _mm_loadu_ps(data + i);
+    low = _mm_add_pd(low, _mm_cvtps_pd(block));
+    high = _mm_add_pd(high, _mm_cvtps_pd(_mm_movehl_ps(block, block)));
+  }
+  alignas(16) double parts[2];
+  _mm_store_pd(parts, _mm_add_pd(low, high));
+  return parts[0] + parts[1] + SumScalar(data + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline int64_t SumAvx2(const int32_t *data,
+                                                       size_t n) {
+  __m256i low = _mm256_setzero_si256();
+  __m256i high = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    low = _mm256_add_epi64(
+        low, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(block)));
+    high = _mm256_add_epi64(
+        high, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(block, 1)));
+  }
+  alignas(32) int64_t parts[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(parts),
+                     _mm256_add_epi64(low, high));
+  return parts[0] + parts[1] + parts[2] + parts[3] +
+         SumScalar(data + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline double SumAvx2(const float *data,
+                                                      size_t n) {
+  __m256d low = _mm256_setzero_pd();
+  __m256d high = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 block = _mm256_loadu_ps(data + i);
+    low = _mm256_add_pd(low, _mm256_cvtps_pd(_mm256_castps256_ps128(block)));
+    high =
+        _mm256_add_pd(high, _mm256_cvtps_pd(_mm256_extractf128_ps(block, 1)));
+  }
+  alignas(32) double parts[4];
+  _mm256_store_pd(parts, _mm256_add_pd(low, high));
+  return parts[0] + parts[1] + parts[2] + parts[3] +
+         SumScalar(data + i, n - i);
+}
+#endif
+
+template <class T>
+struct HasKernels
+    : std::integral_constant<bool, std::is_same<T, int32_t>::value ||
+                                       std::is_same<T, float>::value> {};
+
+template <class T>
+size_t Find(const T *data, size_t n, T value, Level level = ActiveLevel()) {
+#ifdef S21_SIMD_X86
+  if constexpr (HasKernels<T>::value) {
+    if (level == Level::kAvx2) return FindAvx2(data, n, value);
+    if (level == Level::kSse2) return FindSse2(data, n, value);
+  }
+#endif
+  (void)level;
+  return FindScalar(data, n, value);
+}
+
+template <class T>
+size_t Count(const T *data, size_t n, T value, Level level = ActiveLevel()) {
+#ifdef S21_SIMD_X86
+  if constexpr (HasKernels<T>::value) {
+    if (level == Level::kAvx2) return CountAvx2(data, n, value);
+    if (level == Level::kSse2) return CountSse2(data, n, value);
+  }
+#endif
+  (void)level;
+  return CountScalar(data, n, value);
+}
+
+template <bool kMax, class T>
+T MinMax(const T *data, size_t n, Level level = ActiveLevel()) {
+#ifdef S21_SIMD_X86
+  if constexpr (HasKernels<T>::value) {
+    if (level == Level::kAvx2) return MinMaxAvx2<kMax>(data, n);
+    if (level == Level::kSse2) return MinMaxSse2<kMax>(data, n);
+  }
+#endif
+  (void)level;
+  return MinMaxScalar<kMax>(data, n);
+}
+
+template <class T>
+SumType<T> Sum(const T *data, size_t n, Level level = ActiveLevel()) {
+#ifdef S21_SIMD_X86
+  if constexpr (HasKernels<T>::value) {
+    if (level == Level::kAvx2) return SumAvx2(data, n);
+    if (level == Level::kSse2) return SumSse2(data, n);
+  }
+#endif
+  (void)level;
+  return SumScalar(data, n);
+}
+}  // namespace simd
+
+template <class T>
+typename Vector<T>::iterator find(Vector<T> &v, const T &value) {
+  static_assert(std::is_arithmetic<T>::value, "s21::find: arithmetic T only");
+  return typename Vector<T>::iterator(v.data() +
+                                      simd::Find(v.data(), v.size(), value));
+}
+
+template <class T>
+bool contains(const Vector<T> &v, const T &value) {
+  static_assert(std::is_arithmetic<T>::value,
+                "s21::contains: arithmetic T only");
+  return simd::Find(v.data(), v.size(), value) != v.size();
+}
+
+template <class T>
+size_t count(const Vector<T> &v, const T &value) {
+  static_assert(std::is_arithmetic<T>::value, "s21::count: arithmetic T only");
+  return simd::Count(v.data(), v.size(), value);
+}
+
+template <class T>
+T min(const Vector<T> &v) {
+  static_assert(std::is_arithmetic<T>::value, "s21::min: arithmetic T only");
+  if (v.empty()) throw std::out_of_range("s21::min: empty vector");
+  return simd::MinMax<false>(v.data(), v.size());
+}
+
+template <class T>
+T max(const Vector<T> &v) {
+  static_assert(std::is_arithmetic<T>::value, "s21::max: arithmetic T only");
+  if (v.empty()) throw std::out_of_range("s21::max: empty vector");
+  return simd::MinMax<true>(v.data(), v.size());
+}
+
+template <class T>
+simd::SumType<T> sum(const Vector<T> &v) {
+  static_assert(std::is_arithmetic<T>::value, "s21::sum: arithmetic T only");
+  return simd::Sum(v.data(), v.size());
+}
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_SIMD_H_
@@ -0,0 +1,201 @@
+#ifndef CONTAINERS_SRC_S21_SMALLVECTOR_H_
+#define CONTAINERS_SRC_S21_SMALLVECTOR_H_
+
+#include <iostream>
+#include <limits>
+#include <utility>
+
+#include "s21_vector.h"
+
+namespace s21 {
+template <typename T, size_t N = 8>
+class SmallVector {
+  static_assert(N > 0, "s21::SmallVector needs at least one inline slot");
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = typename Vector<T>::iterator;
+  using const_iterator = typename Vector<T>::const_iterator;
+  using size_type = size_t;
+
+  SmallVector() : size_(0), capacity_(N), array_(inline_) {}
+
+  SmallVector(size_type n) : SmallVector() {
+    reserve(n);
+    for (size_type i = 0; i < n; ++i) array_[i] = value_type();
+    size_ = n;
+  }
+
+  SmallVector(std::initializer_list<value_type> const &items)
+      : SmallVector() {
+    reserve(items.size());
+    for (auto it = items.begin(); it != items.end(); ++it)
+      array_[size_++] = *it;
+  }
+
+  SmallVector(const SmallVector &v) : SmallVector() {
+    reserve(v.size_);
+    for (size_type i = 0; i < v.size_; ++i) array_[i] = v.array_[i];
+    size_ = v.size_;
+  }
+
+  SmallVector(SmallVector &&v) : SmallVector() { MoveFrom(v); }
+
+  ~SmallVector() { Release(); }
+
+  SmallVector &operator=(const SmallVector &v) {
+    if (this != &v) {
+      clear();
+      reserve(v.size_);
+      for (size_type i = 0; i < v.size_; ++i) array_[i] = v.array_[i];
+      size_ = v.size_;
+    }
+    return *this;
+  }
+
+  SmallVector &operator=(SmallVector &&v) {
+    if (this != &v) {
+      clear();
+      Release();
+      MoveFrom(v);
+    }
+    return *this;
+  }
+
+  reference at(size_type pos) {
+    if (pos >= size_)
+      throw std::out_of_range("at(): invalid input, index out of bounds");
+    return array_[pos];
+  }
+
+  reference operator[](size_type pos) { return array_[pos]; }
+  const_reference operator[](size_type pos) const { return array_[pos]; }
+
+  const_reference front() const { return array_[0]; }
+  const_reference back() const { return array_[size_ - 1]; }
+
+  T *data() { return array_; }
+  const T *data() const { return array_; }
+
+  iterator begin() { return iterator(array_); }
+  iterator end() { return iterator(array_ + size_); }
+
+  const_iterator cbegin() const { return const_iterator(array_); }
+  const_iterator cend() const { return const_iterator(array_ + size_); }
+
+  bool empty() const { return !(bool)size_; }
+  size_type size() const { return size_; }
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / (2 * sizeof(value_type));
+  }
+
+  bool is_inline() const { return array_ == inline_; }
+
+  void reserve(size_type size) {
+    if (size > capacity_) Reallocate(size);
+  }
+
+  size_type capacity() const { return capacity_; }
+
+  void shrink_to_fit() {
+    if (!is_inline() && size_ < capacity_) Reallocate(size_);
+  }
+
+  void clear() {
+    for (size_type i = 0; i < size_; i++) array_[i] = value_type();
+    size_ = 0;
+  }
+
+  iterator insert(iterator pos, const_reference value) {
+    size_type count = 0;
+    for (iterator it = end(); it != pos; --it) ++count;
+    value_type copy = value;
+    if (size_ == capacity_) reserve(capacity_ * 2);
+    for (size_type i = size_; i != size_ - count; --i)
+      array_[i] = std::move(array_[i - 1]);
+    array_[size_ - count] = std::move(copy);
+    ++size_;
+    return iterator(array_ + size_ - 1 - count);
+  }
+
+  void erase(iterator pos) {
+    iterator it = pos;
+    iterator it_2 = pos + 1;
+    while (it_2 != end()) {
+      *it = std::move(*it_2);
+      ++it;
+      ++it_2;
+    }
+    *it = value_type();
+    --size_;
+  }
+
+  void push_back(const_reference value) {
+    if (size_ == capacity_) {
+      value_type copy = value;
+      reserve(capacity_ * 2);
+      array_[size_++] = std::move(copy);
+    } else {
+      array_[size_++] = value;
+    }
+  }
+
+  void pop_back() {
+    if (size_) array_[--size_] = value_type();
+  }
+
+  void swap(SmallVector &other) {
+    if (!is_inline() && !other.is_inline()) {
+      std::swap(array_, other.array_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+    } else if (this != &other) {
+      SmallVector tmp(std::move(other));
+      other = std::move(*this);
+      *this = std::move(tmp);
+    }
+  }
+
+ private:
+  size_type size_;
+  size_type capacity_;
+  value_type *array_;
+  value_type inline_[N];
+
+  void Reallocate(size_type capacity) {
+    value_type *temp = capacity <= N ? inline_ : new value_type[capacity];
+    if (temp != array_) {
+      for (size_type i = 0; i < size_; ++i) temp[i] = std::move(array_[i]);
+      Release();
+      array_ = temp;
+    }
+    capacity_ = capacity <= N ? N : capacity;
+  }
+
+  void Release() {
+    if (!is_inline()) delete[] array_;
+    array_ = inline_;
+    capacity_ = N;
+  }
+
+  void MoveFrom(SmallVector &v) {
+    if (v.is_inline()) {
+      for (size_type i = 0; i < v.size_; ++i)
+        array_[i] = std::move(v.inline_[i]);
+      size_ = v.size_;
+      v.clear();
+    } else {
+      array_ = v.array_;
+      size_ = v.size_;
+      capacity_ = v.capacity_;
+      v.array_ = v.inline_;
+      v.size_ = 0;
+      v.capacity_ = N;
+    }
+  }
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_SMALLVECTOR_H_
@@ -0,0 +1,243 @@
+#ifndef CONTAINERS_SRC_S21_SNAPSHOT_H_
+#define CONTAINERS_SRC_S21_SNAPSHOT_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+namespace snapshot {
+// File layout, version 1: a 64-byte Header followed by the keys and then, for
+// a Map, the values. Trivially copyable types are stored as raw arrays, each
+// starting on a 64-byte boundary so the file can be mapped and searched in
+// place. Other types are streamed element by element through WriteValue and
+// ReadValue overloads; the header records their size as 0.
+enum Kind : uint32_t { kVector = 1, kSet = 2, kMap = 3 };
+
+constexpr char kMagic[8] = {'S', '2', '1', 'S', 'N', 'A', 'P', '\0'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kAlignment = 64;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t kind;
+  uint32_t key_size;
+  uint32_t value_size;
+  uint64_t count;
+  uint8_t reserved[32];
+};
+static_assert(sizeof(Header) == kAlignment, "snapshot header must be 64 bytes");
+
+// Bytes per element in the raw array format, or 0 if T is streamed.
+template <class T>
+constexpr uint32_t SizeOf() {
+  return std::is_trivially_copyable<T>::value ? (uint32_t)sizeof(T) : 0;
+}
+
+inline size_t AlignUp(size_t offset) {
+  return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+class Writer;
+class Reader;
+
+inline void WriteValue(Writer &writer, const std::string &value);
+inline void ReadValue(Reader &reader, std::string &value);
+template <class A, class B>
+void WriteValue(Writer &writer, const std::pair<A, B> &value);
+template <class A, class B>
+void ReadValue(Reader &reader, std::pair<A, B> &value);
+
+// Writes to path + ".tmp" and renames it over path on Close(), so a failed
+// or interrupted save leaves any previous snapshot intact.
+class Writer {
+ public:
+  explicit Writer(const std::string &path)
+      : path_(path),
+        temp_(path + ".tmp"),
+        file_(std::fopen(temp_.c_str(), "wb")) {
+    if (!file_) throw std::runtime_error("s21::save: cannot open " + temp_);
+  }
+
+  Writer(const Writer &) = delete;
+  Writer &operator=(const Writer &) = delete;
+
+  ~Writer() {
+    if (file_) {
+      std::fclose(file_);
+      std::remove(temp_.c_str());
+    }
+  }
+
+  void Begin(Kind kind, uint32_t key_size, uint32_t value_size,
+             uint64_t count) {
+    Header header = {};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.kind = kind;
+    header.key_size = key_size;
+    header.value_size = value_size;
+    header.count = count;
+    WriteBytes(&header, sizeof(header));
+  }
+
+  void WriteBytes(const void *data, size_t size) {
+    if (size && std::fwrite(data, 1, size, file_) != size)
+      throw std::runtime_error("s21::save: write failed");
+    offset_ += size;
+  }
+
+  template <class T>
+  void Write(const T &value) {
+    if constexpr (std::is_trivially_copyable<T>::value)
+      WriteBytes(&value, sizeof(T));
+    else
+      WriteValue(*this, value);
+  }
+
+  template <class T>
+  void WriteArray(const T *data, size_t n) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      WriteBytes(data, n * sizeof(T));
+    } else {
+      for (size_t i = 0; i < n; ++i) Write(data[i]);
+    }
+  }
+
+  // Pads with zeros up to the next 64-byte boundary.
+  void Align() {
+    static const char kZeros[kAlignment] = {};
+    WriteBytes(kZeros, AlignUp(offset_) - offset_);
+  }
+
+  void Close() {
+    Align();
+    int failed = std::fclose(file_);
+    file_ = nullptr;
+    if (!failed) failed = std::rename(temp_.c_str(), path_.c_str());
+    if (failed) {
+      std::remove(temp_.c_str());
+      throw std::runtime_error("s21::save: cannot write " + path_);
+    }
+  }
+
+ private:
+  std::string path_;
+  std::string temp_;
+  std::FILE *file_;
+  size_t offset_ = 0;
+};
+
+class Reader {
+ public:
+  explicit Reader(const std::string &path)
+      : file_(std::fopen(path.c_str(), "rb")) {
+    if (!file_) throw std::runtime_error("s21::load: cannot open " + path);
+    long size = -1;
+    if (!std::fseek(file_, 0, SEEK_END)) size = std::ftell(file_);
+    if (size < 0 || std::fseek(file_, 0, SEEK_SET)) {
+      std::fclose(file_);
+      throw std::runtime_error("s21::load: cannot read " + path);
+    }
+    size_ = size;
+  }
+
+  Reader(const Reader &) = delete;
+  Reader &operator=(const Reader &) = delete;
+
+  ~Reader() {
+    if (file_) std::fclose(file_);
+  }
+
+  // Checks the header against what the caller expects and returns the
+  // element count. Callers reserve memory for that many elements, so the
+  // count is also checked against the rest of the file, taking streamed
+  // elements to be at least a byte each.
+  uint64_t Begin(Kind kind, uint32_t key_size, uint32_t value_size) {
+    Header header;
+    ReadBytes(&header, sizeof(header));
+    Check(header, kind, key_size, value_size);
+    size_t element_size = (key_size ? key_size : 1);
+    if (kind == kMap) element_size += (value_size ? value_size : 1);
+    if (header.count > (size_ - offset_) / element_size)
+      throw std::runtime_error("s21::load: truncated snapshot");
+    return header.count;
+  }
+
+  static void Check(const Header &header, Kind kind, uint32_t key_size,
+                    uint32_t value_size) {
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)))
+      throw std::runtime_error("s21::load: not a snapshot file");
+    if (header.version != kVersion)
+      throw std::runtime_error("s21::load: unsupported snapshot version");
+    if (header.kind != kind || header.key_size != key_size ||
+        header.value_size != value_size)
+      throw std::runtime_error("s21::load: snapshot type mismatch");
+  }
+
+  void ReadBytes(void *data, size_t size) {
+    if (size && std::fread(data, 1, size, file_) != size)
+      throw std::runtime_error("s21::load: truncated snapshot");
+    offset_ += size;
+  }
+
+  template <class T>
+  void Read(T &value) {
+    if constexpr (std::is_trivially_copyable<T>::value)
+      ReadBytes(&value, sizeof(T));
+    else
+      ReadValue(*this, value);
+  }
+
+  template <class T>
+  void ReadArray(T *data, size_t n) {
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      ReadBytes(data, n * sizeof(T));
+    } else {
+      for (size_t i = 0; i < n; ++i) Read(data[i]);
+    }
+  }
+
+  void Align() {
+    char padding[kAlignment];
+    ReadBytes(padding, AlignUp(offset_) - offset_);
+  }
+
+ private:
+  std::FILE *file_;
+  size_t size_;
+  size_t offset_ = 0;
+};
+
+inline void WriteValue(Writer &writer, const std::string &value) {
+  writer.Write((uint64_t)value.size());
+  writer.WriteBytes(value.data(), value.size());
+}
+
+inline void ReadValue(Reader &reader, std::string &value) {
+  uint64_t size = 0;
+  reader.Read(size);
+  value.resize(size);
+  reader.ReadBytes(&value[0], size);
+}
+
+template <class A, class B>
+void WriteValue(Writer &writer, const std::pair<A, B> &value) {
+  writer.Write(value.first);
+  writer.Write(value.second);
+}
+
+template <class A, class B>
+void ReadValue(Reader &reader, std::pair<A, B> &value) {
+  reader.Read(value.first);
+  reader.Read(value.second);
+}
+}  // namespace snapshot
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_SNAPSHOT_H_
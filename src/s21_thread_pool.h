@@ -0,0 +1,258 @@
+#ifndef CONTAINERS_SRC_S21_THREAD_POOL_H_
+#define CONTAINERS_SRC_S21_THREAD_POOL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "s21_queue.h"
+#include "s21_vector.h"
+#include "s21_work_stealing_deque.h"
+
+namespace s21 {
+// Work-stealing pool. Each worker owns a WorkStealingDeque: tasks submitted
+// from a worker go to the bottom of its own deque and are run newest first,
+// while idle workers steal the oldest, i.e. largest, pieces from others.
+// Tasks submitted from other threads go through a shared queue. Waiting
+// threads run tasks while any are available, so parallel_for may be
+// nested; threads outside the pool then sleep until their work is done.
+// Tasks must not throw.
+class ThreadPool {
+ public:
+  explicit ThreadPool(unsigned threads = 0) {
+    if (!threads) threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < threads; ++i)
+      deques_.push_back(new WorkStealingDeque<Task *>);
+    for (unsigned i = 0; i < threads; ++i)
+      workers_.push_back(new std::thread([this, i] { Work(i); }));
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Finishes every submitted task first.
+  ~ThreadPool() {
+    wait();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    // Any worker may still be stealing from any deque until it is joined.
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      workers_[i]->join();
+      delete workers_[i];
+    }
+    for (size_t i = 0; i < deques_.size(); ++i) delete deques_[i];
+  }
+
+  size_t size() const { return workers_.size(); }
+
+  template <class F>
+  void submit(F fn) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    Push(new FunctionTask<F>(std::move(fn), &pending_));
+  }
+
+  // Runs tasks on the calling thread until every submitted task is done.
+  void wait() { HelpUntil(pending_); }
+
+  // Calls fn(lo, hi) on disjoint subranges of [first, last), none longer
+  // than grain, and returns when all have finished.
+  template <class F>
+  void parallel_for(size_t first, size_t last, size_t grain, F fn) {
+    if (first >= last) return;
+    if (!grain) grain = 1;
+    std::atomic<size_t> left{0};
+    RangeTask<F>(this, &fn, first, last, grain, &left).Run();
+    HelpUntil(left);
+  }
+
+ private:
+  struct Task {
+    std::atomic<size_t> *counter_;
+
+    explicit Task(std::atomic<size_t> *counter) : counter_(counter) {}
+    virtual ~Task() {}
+    virtual void Run() = 0;
+  };
+
+  template <class F>
+  struct FunctionTask : Task {
+    F fn_;
+
+    FunctionTask(F &&fn, std::atomic<size_t> *counter)
+        : Task(counter), fn_(std::move(fn)) {}
+    void Run() override { fn_(); }
+  };
+
+  // Splits off the upper half as a new task until the range fits in grain,
+  // so thieves take large pieces and the owner keeps working on small ones.
+  template <class F>
+  struct RangeTask : Task {
+    ThreadPool *pool_;
+    F *fn_;
+    size_t first_;
+    size_t last_;
+    size_t grain_;
+
+    RangeTask(ThreadPool *pool, F *fn, size_t first, size_t last,
+              size_t grain, std::atomic<size_t> *counter)
+        : Task(counter),
+          pool_(pool),
+          fn_(fn),
+          first_(first),
+          last_(last),
+          grain_(grain) {}
+
+    void Run() override {
+      while (last_ - first_ > grain_) {
+        size_t middle = first_ + (last_ - first_) / 2;
+        this->counter_->fetch_add(1, std::memory_order_relaxed);
+        pool_->Push(new RangeTask(pool_, fn_, middle, last_, grain_,
+                                  this->counter_));
+        last_ = middle;
+      }
+      (*fn_)(first_, last_);
+    }
+  };
+
+  Vector<WorkStealingDeque<Task *> *> deques_;
+  Vector<std::thread *> workers_;
+  std::atomic<size_t> pending_{0};
+
+  std::mutex mutex_;
+  Queue<Task *> injected_;
+  std::atomic<size_t> injected_size_{0};
+  std::condition_variable wake_;
+  // Bumped on every push and whenever a wait counter drops to zero; a
+  // thread only sleeps if it has not changed since it last looked for work.
+  std::atomic<uint64_t> epoch_{0};
+  std::atomic<size_t> sleeping_{0};
+  bool stopping_ = false;
+
+  struct Worker {
+    const ThreadPool *pool_ = nullptr;
+    int index_ = -1;
+  };
+
+  static Worker &CurrentWorker() {
+    thread_local Worker worker;
+    return worker;
+  }
+
+  // Index of the calling thread's deque in this pool, or -1.
+  int WorkerIndex() const {
+    const Worker &worker = CurrentWorker();
+    return worker.pool_ == this ? worker.index_ : -1;
+  }
+
+  void Push(Task *task) {
+    int index = WorkerIndex();
+    if (index >= 0) {
+      deques_[index]->push(task);
+    } else {
+      std::lock_guard<std::mutex> lock(mutex_);
+      injected_.push(task);
+      injected_size_.fetch_add(1, std::memory_order_relaxed);
+    }
+    epoch_.fetch_add(1);
+    if (sleeping_.load()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      wake_.notify_one();
+    }
+  }
+
+  // Own deque first, then the shared queue, then a steal sweep starting at
+  // a random victim.
+  Task *Find() {
+    Task *task = nullptr;
+    int index = WorkerIndex();
+    if (index >= 0 && deques_[index]->pop(task)) return task;
+    if (injected_size_.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!injected_.empty()) {
+        task = injected_.front();
+        injected_.pop();
+        injected_size_.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+      }
+    }
+    size_t n = deques_.size();
+    size_t start = Random() % n;
+    for (size_t i = 0; i < n; ++i) {
+      size_t victim = (start + i) % n;
+      if ((int)victim != index && deques_[victim]->steal(task)) return task;
+    }
+    return nullptr;
+  }
+
+  // The counter may live on a waiter's stack, so it is not touched after
+  // it drops to zero; sleeping waiters are woken through the epoch.
+  void Execute(Task *task) {
+    std::atomic<size_t> *counter = task->counter_;
+    task->Run();
+    delete task;
+    if (counter->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      epoch_.fetch_add(1);
+      if (sleeping_.load()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wake_.notify_all();
+      }
+    }
+  }
+
+  // Workers keep polling, since the tasks they wait for may be stolen
+  // from their own deque; other threads block once nothing is left to run.
+  void HelpUntil(const std::atomic<size_t> &counter) {
+    bool worker = WorkerIndex() >= 0;
+    while (counter.load(std::memory_order_acquire)) {
+      uint64_t epoch = epoch_.load();
+      if (Task *task = Find()) {
+        Execute(task);
+      } else if (worker) {
+        std::this_thread::yield();
+      } else {
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleeping_.fetch_add(1);
+        wake_.wait(lock, [&] {
+          return !counter.load(std::memory_order_acquire) ||
+                 epoch_.load() != epoch;
+        });
+        sleeping_.fetch_sub(1);
+      }
+    }
+  }
+
+  void Work(int index) {
+    CurrentWorker().pool_ = this;
+    CurrentWorker().index_ = index;
+    while (true) {
+      uint64_t epoch = epoch_.load();
+      if (Task *task = Find()) {
+        Execute(task);
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      sleeping_.fetch_add(1);
+      wake_.wait(lock, [&] { return stopping_ || epoch_.load() != epoch; });
+      sleeping_.fetch_sub(1);
+      if (stopping_) return;
+    }
+  }
+
+  static uint32_t Random() {
+    thread_local uint32_t state = 0x9e3779b9u ^ (uint32_t)(uintptr_t)&state;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  }
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_THREAD_POOL_H_
@@ -0,0 +1,42 @@
+#ifndef CONTAINERS_SRC_S21_TREE_LINKS_H_
+#define CONTAINERS_SRC_S21_TREE_LINKS_H_
+
+namespace s21 {
+// In-order successor and predecessor for any node type with parent_, left_
+// and right_ links; shared by the BTree and IntrusiveSet iterators.
+template <class Node>
+Node *TreeNext(Node *node) {
+  if (node->right_) {
+    node = node->right_;
+    while (node->left_) node = node->left_;
+  } else if (node->parent_->left_ == node) {
+    node = node->parent_;
+  } else {
+    Node *child;
+    do {
+      child = node;
+      node = node->parent_;
+    } while (node->right_ == child);
+  }
+  return node;
+}
+
+template <class Node>
+Node *TreePrev(Node *node) {
+  if (node->left_) {
+    node = node->left_;
+    while (node->right_) node = node->right_;
+  } else if (node->parent_->right_ == node) {
+    node = node->parent_;
+  } else {
+    Node *child;
+    do {
+      child = node;
+      node = node->parent_;
+    } while (node->left_ == child);
+  }
+  return node;
+}
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_TREE_LINKS_H_
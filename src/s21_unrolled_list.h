@@ -0,0 +1,397 @@
+#ifndef CONTAINERS_SRC_S21_UNROLLED_LIST_H_
+#define CONTAINERS_SRC_S21_UNROLLED_LIST_H_
+
+#include <algorithm>
+#include <initializer_list>
+#include <limits>
+#include <new>
+#include <utility>
+
+#include "s21_instrumentation.h"
+#include "s21_vector.h"
+
+namespace s21 {
+// List with up to BlockSize elements per node, stored contiguously, so
+// iteration walks arrays and a node's links are shared by many elements.
+//
+// Iterators are (block, index) pairs. insert and erase shift the elements
+// after the position within its block, invalidating iterators to them; an
+// insert into a full block splits it and an erase that leaves a block less
+// than a quarter full may merge it with its successor, which moves elements
+// between blocks. Iterators into other blocks stay valid. splice keeps
+// iterators into the spliced list valid unless it has to split the block at
+// pos. merge, reverse, unique and sort invalidate all iterators.
+template <typename T, size_t BlockSize = (sizeof(T) < 16 ? 256 / sizeof(T)
+                                                          : 16)>
+class UnrolledList {
+  static_assert(BlockSize >= 2, "s21::UnrolledList needs BlockSize >= 2");
+
+ public:
+  using value_type = T;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = size_t;
+
+ private:
+  struct Block {
+    Block* next_ = this;
+    Block* prev_ = this;
+    size_type count_ = 0;
+    alignas(T) unsigned char storage_[BlockSize * sizeof(T)];
+
+    T* data() { return reinterpret_cast<T*>(storage_); }
+  };
+
+ public:
+  class ListIterator {
+   public:
+    ListIterator() : block_(nullptr), index_(0) {}
+    ListIterator(Block* block, size_type index)
+        : block_(block), index_(index) {}
+
+    reference operator*() const { return block_->data()[index_]; }
+
+    ListIterator& operator++() {
+      if (++index_ >= block_->count_) {
+        block_ = block_->next_;
+        index_ = 0;
+      }
+      return *this;
+    }
+
+    ListIterator operator++(int) {
+      ListIterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    ListIterator& operator--() {
+      if (index_) {
+        --index_;
+      } else {
+        block_ = block_->prev_;
+        index_ = block_->count_ ? block_->count_ - 1 : 0;
+      }
+      return *this;
+    }
+
+    ListIterator operator--(int) {
+      ListIterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+
+    ListIterator operator+(int n) const {
+      ListIterator tmp = *this;
+      for (int i = 0; i < n; ++i) ++tmp;
+      return tmp;
+    }
+
+    ListIterator operator-(int n) const {
+      ListIterator tmp = *this;
+      for (int i = 0; i < n; ++i) --tmp;
+      return tmp;
+    }
+
+    bool operator==(const ListIterator& other) const {
+      return block_ == other.block_ && index_ == other.index_;
+    }
+
+    bool operator!=(const ListIterator& other) const {
+      return !(*this == other);
+    }
+
+   protected:
+    friend class UnrolledList;
+    Block* block_;
+    size_type index_;
+  };
+
+  class ListConstIterator : public ListIterator {
+   public:
+    using ListIterator::ListIterator;
+    ListConstIterator(const ListIterator& other) : ListIterator(other) {}
+
+    const_reference operator*() const { return ListIterator::operator*(); }
+  };
+
+  using iterator = ListIterator;
+  using const_iterator = ListConstIterator;
+
+  UnrolledList() {}
+
+  explicit UnrolledList(size_type n) {
+    for (size_type i = 0; i < n; ++i) push_back(value_type());
+  }
+
+  UnrolledList(std::initializer_list<value_type> const& items) {
+    for (auto it = items.begin(); it != items.end(); ++it) push_back(*it);
+  }
+
+  UnrolledList(const UnrolledList& l) {
+    for (auto it = l.cbegin(); it != l.cend(); ++it) push_back(*it);
+  }
+
+  UnrolledList(UnrolledList&& l) { swap(l); }
+
+  ~UnrolledList() {
+    clear();
+    delete head_;
+  }
+
+  UnrolledList& operator=(const UnrolledList& l) {
+    if (this != &l) {
+      UnrolledList copy(l);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  UnrolledList& operator=(UnrolledList&& l) {
+    swap(l);
+    return *this;
+  }
+
+  const_reference front() const { return head_->next_->data()[0]; }
+  const_reference back() const {
+    return head_->prev_->data()[head_->prev_->count_ - 1];
+  }
+
+  iterator begin() { return iterator(head_->next_, 0); }
+  iterator end() { return iterator(head_, 0); }
+  const_iterator cbegin() const { return const_iterator(head_->next_, 0); }
+  const_iterator cend() const { return const_iterator(head_, 0); }
+
+  bool empty() const { return !size_; }
+  size_type size() const { return size_; }
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(value_type);
+  }
+
+  void clear() {
+    Block* block = head_->next_;
+    while (block != head_) {
+      Block* next = block->next_;
+      Destroy(block, 0);
+      delete block;
+      block = next;
+    }
+    head_->next_ = head_->prev_ = head_;
+    size_ = 0;
+  }
+
+  iterator insert(iterator pos, const_reference value) {
+    value_type copy(value);
+    Block* block = pos.block_;
+    size_type index = pos.index_;
+    if (block == head_) {
+      block = head_->prev_;
+      index = block->count_;
+      if (block == head_ || block->count_ == BlockSize) {
+        block = NewBlockAfter(head_->prev_);
+        index = 0;
+      }
+    } else if (block->count_ == BlockSize) {
+      if (index == 0 && block->prev_ != head_ &&
+          block->prev_->count_ < BlockSize) {
+        block = block->prev_;
+        index = block->count_;
+      } else {
+        Block* upper = Split(block, BlockSize / 2);
+        if (index > block->count_) {
+          index -= block->count_;
+          block = upper;
+        }
+      }
+    }
+    T* data = block->data();
+    if (index == block->count_) {
+      new (data + index) value_type(std::move(copy));
+    } else {
+      size_type last = block->count_ - 1;
+      new (data + last + 1) value_type(std::move(data[last]));
+      std::move_backward(data + index, data + last, data + last + 1);
+      data[index] = std::move(copy);
+    }
+    ++block->count_;
+    ++size_;
+    S21_COUNT(list_inserts, 1);
+    return iterator(block, index);
+  }
+
+  void erase(iterator pos) {
+    Block* block = pos.block_;
+    T* data = block->data();
+    std::move(data + pos.index_ + 1, data + block->count_, data + pos.index_);
+    data[--block->count_].~T();
+    --size_;
+    S21_COUNT(list_erases, 1);
+    Block* next = block->next_;
+    if (!block->count_) {
+      Unlink(block);
+    } else if (block->count_ < BlockSize / 4 && next != head_ &&
+               block->count_ + next->count_ <= BlockSize) {
+      T* to = data + block->count_;
+      for (size_type i = 0; i < next->count_; ++i) {
+        new (to + i) value_type(std::move(next->data()[i]));
+        next->data()[i].~T();
+      }
+      block->count_ += next->count_;
+      Unlink(next);
+    }
+  }
+
+  void push_back(const_reference value) { insert(end(), value); }
+  void push_front(const_reference value) { insert(begin(), value); }
+
+  void pop_back() {
+    if (size_) erase(iterator(head_->prev_, head_->prev_->count_ - 1));
+  }
+
+  void pop_front() {
+    if (size_) erase(begin());
+  }
+
+  void swap(UnrolledList& other) {
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+  }
+
+  // Both lists must be sorted; other is left empty. Equal elements of this
+  // list come first.
+  void merge(UnrolledList& other) {
+    if (this == &other || other.empty()) return;
+    UnrolledList merged;
+    iterator a = begin();
+    iterator b = other.begin();
+    while (a != end() && b != other.end()) {
+      if (*b < *a)
+        merged.AppendMoved(*b++);
+      else
+        merged.AppendMoved(*a++);
+    }
+    for (; a != end(); ++a) merged.AppendMoved(*a);
+    for (; b != other.end(); ++b) merged.AppendMoved(*b);
+    other.clear();
+    swap(merged);
+  }
+
+  // Moves every element of other before pos by relinking its blocks.
+  void splice(const_iterator pos, UnrolledList& other) {
+    if (this == &other || other.empty()) return;
+    Block* next = pos.block_;
+    if (pos.index_) next = Split(pos.block_, pos.index_);
+    Block* prev = next->prev_;
+    Block* first = other.head_->next_;
+    Block* last = other.head_->prev_;
+    prev->next_ = first;
+    first->prev_ = prev;
+    last->next_ = next;
+    next->prev_ = last;
+    size_ += other.size_;
+    other.head_->next_ = other.head_->prev_ = other.head_;
+    other.size_ = 0;
+  }
+
+  void reverse() {
+    Block* block = head_;
+    do {
+      std::swap(block->next_, block->prev_);
+      std::reverse(block->data(), block->data() + block->count_);
+      block = block->next_;
+    } while (block != head_);
+  }
+
+  // Removes consecutive duplicates.
+  void unique() {
+    if (size_ < 2) return;
+    iterator write = begin();
+    for (iterator read = begin() + 1; read != end(); ++read) {
+      if (!(*read == *write)) {
+        ++write;
+        if (write != read) *write = std::move(*read);
+      }
+    }
+    Truncate(++write);
+  }
+
+  // Stable. Elements are sorted in a Vector and moved back in place.
+  void sort() {
+    if (size_ < 2) return;
+    Vector<value_type> buffer;
+    buffer.reserve(size_);
+    for (iterator it = begin(); it != end(); ++it)
+      buffer.push_back(std::move(*it));
+    std::stable_sort(buffer.data(), buffer.data() + size_);
+    size_type i = 0;
+    for (iterator it = begin(); it != end(); ++it, ++i)
+      *it = std::move(buffer[i]);
+  }
+
+ private:
+  Block* head_ = new Block;
+  size_type size_ = 0;
+
+  Block* NewBlockAfter(Block* prev) {
+    Block* block = new Block;
+    block->prev_ = prev;
+    block->next_ = prev->next_;
+    prev->next_->prev_ = block;
+    prev->next_ = block;
+    return block;
+  }
+
+  // Moves the elements from index on into a new block after block.
+  Block* Split(Block* block, size_type index) {
+    Block* upper = NewBlockAfter(block);
+    T* from = block->data();
+    T* to = upper->data();
+    for (size_type i = index; i < block->count_; ++i) {
+      new (to + (i - index)) value_type(std::move(from[i]));
+      from[i].~T();
+    }
+    upper->count_ = block->count_ - index;
+    block->count_ = index;
+    return upper;
+  }
+
+  void Unlink(Block* block) {
+    block->prev_->next_ = block->next_;
+    block->next_->prev_ = block->prev_;
+    delete block;
+  }
+
+  // Destroys the elements of block from index on.
+  void Destroy(Block* block, size_type index) {
+    for (size_type i = index; i < block->count_; ++i) block->data()[i].~T();
+    block->count_ = index;
+  }
+
+  // Erases every element from pos to the end.
+  void Truncate(iterator pos) {
+    if (pos == end()) return;
+    Block* block = pos.block_;
+    size_ -= block->count_ - pos.index_;
+    Destroy(block, pos.index_);
+    Block* next = block->next_;
+    if (!block->count_) Unlink(block);
+    while (next != head_) {
+      Block* after = next->next_;
+      size_ -= next->count_;
+      Destroy(next, 0);
+      Unlink(next);
+      next = after;
+    }
+  }
+
+  void AppendMoved(value_type& value) {
+    Block* last = head_->prev_;
+    if (last == head_ || last->count_ == BlockSize) last = NewBlockAfter(last);
+    new (last->data() + last->count_) value_type(std::move(value));
+    ++last->count_;
+    ++size_;
+  }
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_UNROLLED_LIST_H_
@@ -4,6 +4,9 @@
 #include <iostream>
 #include <limits>
 
+#include "s21_instrumentation.h"
+#include "s21_snapshot.h"
+
 namespace s21 {
 template <typename T>
 class Vector {
@@ -23,14 +26,20 @@ class Vector {
       ++array_ptr_;
       return temp;
     }
-    Iterator &operator++() { return ++array_ptr_; }
+    Iterator &operator++() {
+      ++array_ptr_;
+      return *this;
+    }
 
     Iterator operator--(int) {
       Iterator temp = array_ptr_;
       --array_ptr_;
       return temp;
     }
-    Iterator &operator--() { return --array_ptr_; }
+    Iterator &operator--() {
+      --array_ptr_;
+      return *this;
+    }
 
     Iterator operator+(int n) { return array_ptr_ + n; }
     Iterator operator-(int n) { return array_ptr_ - n; }
@@ -89,7 +98,7 @@ class Vector {
     } else {
       array_ = new value_type[n];
       for (size_type i = 0; i < size_; i++) {
-        array_[i] = 0;
+        array_[i] = value_type();
       }
     }
   }
@@ -104,7 +113,7 @@ class Vector {
   Vector(const Vector &v)
       : size_(v.size_), capacity_(v.capacity_), array_(new value_type[size_]) {
     const_iterator it = v.cbegin();
-    int i = 0;
+    size_type i = 0;
     while (it != v.cend()) {
       array_[i] = *it;
       ++i;
@@ -150,16 +159,17 @@ class Vector {
   reference operator[](size_type pos) { return array_[pos]; }
   const_reference operator[](size_type pos) const { return array_[pos]; }
 
-  const_reference front() {
+  const_reference front() const {
     const value_type &const_ref = array_[0];
     return const_ref;
   }
-  const_reference back() {
+  const_reference back() const {
     const value_type &const_ref = array_[size_ - 1];
     return const_ref;
   }
 
   T *data() { return array_; }
+  const T *data() const { return array_; }
 
   iterator begin() { return iterator(array_); }
   iterator end() { return iterator(array_ + size_); }
@@ -167,15 +177,17 @@ class Vector {
   const_iterator cbegin() const { return const_iterator(array_); }
   const_iterator cend() const { return const_iterator(array_ + size_); }
 
-  bool empty() { return !(bool)size_; }
-  size_type size() { return size_; }
+  bool empty() const { return !(bool)size_; }
+  size_type size() const { return size_; }
   size_type max_size() const {
     return std::numeric_limits<size_type>::max() / (2 * sizeof(value_type));
   }
 
   void reserve(size_type size) {
     if (size > capacity_) {
-      int i = 0;
+      S21_COUNT(vector_growths, 1);
+      S21_COUNT(vector_bytes_allocated, size * sizeof(value_type));
+      size_type i = 0;
       capacity_ = size;
       value_type *temp = new value_type[capacity_];
       Vector<value_type>::iterator it = this->begin();
@@ -189,10 +201,10 @@ class Vector {
     }
   }
 
-  size_type capacity() { return capacity_; }
+  size_type capacity() const { return capacity_; }
 
   void shrink_to_fit() {
-    int i = 0;
+    size_type i = 0;
     capacity_ = this->size();
     value_type *temp = new value_type[capacity_];
     iterator it = this->begin();
@@ -207,20 +219,20 @@ class Vector {
 
   void clear() {
     for (size_type i = 0; i < size_; i++) {
-      array_[i] = '\0';
+      array_[i] = value_type();
     }
     size_ = 0;
   }
 
   iterator insert(iterator pos, const_reference value) {
-    int count = 0;
+    size_type count = 0;
     for (iterator it = this->end(); it != pos; it--) {
       count++;
     }
-    if (size_ == capacity_) this->reserve(this->size_ * 2);
+    if (size_ == capacity_) this->reserve(size_ ? size_ * 2 : 1);
     iterator it = this->end();
     iterator it_2 = it - 1;
-    for (int i = 0; i != count; i++) {
+    for (size_type i = 0; i != count; i++) {
       *it = *it_2;
       it--;
       it_2--;
@@ -239,7 +251,7 @@ class Vector {
       it++;
       it_2++;
     }
-    *it = '\0';
+    *it = value_type();
     size_--;
   }
 
@@ -248,8 +260,8 @@ class Vector {
 
   void swap(Vector &other) {
     value_type *temp = other.data();
-    int size = other.size();
-    int capacity = other.capacity();
+    size_type size = other.size();
+    size_type capacity = other.capacity();
 
     other.array_ = this->data();
     other.size_ = this->size();
@@ -260,6 +272,26 @@ class Vector {
     this->capacity_ = capacity;
   }
 
+  // Writes the elements to a snapshot file; see s21_snapshot.h.
+  void save(const std::string &path) const {
+    snapshot::Writer writer(path);
+    writer.Begin(snapshot::kVector, snapshot::SizeOf<T>(), 0, size_);
+    writer.WriteArray(array_, size_);
+    writer.Close();
+  }
+
+  // Replaces the contents with those of a snapshot written by save(). The
+  // vector is left unchanged if the file cannot be read.
+  void load(const std::string &path) {
+    snapshot::Reader reader(path);
+    size_type n = reader.Begin(snapshot::kVector, snapshot::SizeOf<T>(), 0);
+    Vector loaded;
+    loaded.reserve(n);
+    reader.ReadArray(loaded.array_, n);
+    loaded.size_ = n;
+    swap(loaded);
+  }
+
  private:
   size_type size_;
   size_type capacity_;
@@ -0,0 +1,136 @@
+#ifndef CONTAINERS_SRC_S21_WORK_STEALING_DEQUE_H_
+#define CONTAINERS_SRC_S21_WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#include "s21_vector.h"
+
+namespace s21 {
+// Chase-Lev deque: one owner thread pushes and pops at the bottom, any
+// thread may steal from the top. Owner operations need no CAS except when
+// racing a thief for the last element. Memory orders follow Le et al.,
+// "Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+//
+// The ring doubles when full. Replaced rings are kept until destruction
+// because a thief may still be reading one; they add up to less than the
+// final ring. Elements are stored in atomics, so T must be trivially
+// copyable, typically a pointer to a task.
+template <typename T>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "s21::WorkStealingDeque holds trivially copyable values");
+
+ public:
+  using value_type = T;
+  using size_type = size_t;
+
+  explicit WorkStealingDeque(size_type capacity = 64)
+      : ring_(new Ring(RoundUp(capacity))) {}
+
+  WorkStealingDeque(const WorkStealingDeque &) = delete;
+  WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+  ~WorkStealingDeque() {
+    delete ring_.load(std::memory_order_relaxed);
+    for (size_type i = 0; i < retired_.size(); ++i) delete retired_[i];
+  }
+
+  // Owner only.
+  void push(T value) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    Ring *ring = ring_.load(std::memory_order_relaxed);
+    if (bottom - top >= (int64_t)ring->capacity_)
+      ring = Grow(ring, top, bottom);
+    ring->Put(bottom, value);
+    // A release store rather than the paper's release fence: the same code
+    // on x86 and ARMv8, and visible to ThreadSanitizer.
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // Owner only. Takes the most recently pushed element.
+  bool pop(T &value) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Ring *ring = ring_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+    value = ring->Get(bottom);
+    if (top == bottom) {
+      bool won = top_.compare_exchange_strong(top, top + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed);
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  // Any thread. Takes the oldest element; fails if the deque is empty or
+  // another thread got there first.
+  bool steal(T &value) {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) return false;
+    Ring *ring = ring_.load(std::memory_order_acquire);
+    value = ring->Get(top);
+    return top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed);
+  }
+
+  // Only a hint while other threads operate on the deque.
+  size_type size() const {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? (size_type)(bottom - top) : 0;
+  }
+
+  bool empty() const { return !size(); }
+
+ private:
+  struct Ring {
+    size_type capacity_;
+    std::atomic<T> *slots_;
+
+    explicit Ring(size_type capacity)
+        : capacity_(capacity), slots_(new std::atomic<T>[capacity]) {}
+    ~Ring() { delete[] slots_; }
+
+    T Get(int64_t i) const {
+      return slots_[i & (capacity_ - 1)].load(std::memory_order_relaxed);
+    }
+    void Put(int64_t i, T value) {
+      slots_[i & (capacity_ - 1)].store(value, std::memory_order_relaxed);
+    }
+  };
+
+  alignas(64) std::atomic<int64_t> top_{0};
+  alignas(64) std::atomic<int64_t> bottom_{0};
+  std::atomic<Ring *> ring_;
+  Vector<Ring *> retired_;
+
+  static size_type RoundUp(size_type capacity) {
+    size_type power = 2;
+    while (power < capacity) power *= 2;
+    return power;
+  }
+
+  Ring *Grow(Ring *ring, int64_t top, int64_t bottom) {
+    Ring *bigger = new Ring(ring->capacity_ * 2);
+    for (int64_t i = top; i < bottom; ++i) bigger->Put(i, ring->Get(i));
+    retired_.push_back(ring);
+    ring_.store(bigger, std::memory_order_release);
+    return bigger;
+  }
+};
+}  // namespace s21
+
+#endif  // CONTAINERS_SRC_S21_WORK_STEALING_DEQUE_H_
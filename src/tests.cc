@@ -1,12 +1,27 @@
+#define S21_CONTAINERS_INSTRUMENTATION
+
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
 #include <climits>
+#include <ctime>
 #include <list>
+#include <map>
+#include <numeric>
 #include <queue>
+#include <set>
 #include <stack>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 #include "s21_containers.h"
+#include "s21_containersplus.h"
 
 // S21_MAP
 TEST(MapTest, MapBaseConstruct) {
@@ -210,6 +225,152 @@ TEST(MapTest, MapIter) {
   }
 }
 
+TEST(MapTest, MapInsertHint) {
+  s21::Map<int, int> map({std::pair<int, int>(1, 4), std::pair<int, int>(5, 5),
+                          std::pair<int, int>(9, 7)});
+  auto it = map.insert(map.begin() + 1, {3, 6});
+  ASSERT_EQ((*it).first, 3);
+  it = map.insert(map.end(), {12, 8});
+  ASSERT_EQ((*it).second, 8);
+  it = map.insert(map.begin(), {9, 100});
+  ASSERT_EQ((*it).second, 7);
+  ASSERT_EQ(map.size(), (unsigned long)5);
+  int check[5] = {1, 3, 5, 9, 12};
+  int i = 0;
+  for (auto item : map) ASSERT_EQ(item.first, check[i++]);
+}
+
+TEST(MapTest, MapEmplaceHint) {
+  s21::Map<int, int> map;
+  for (int i = 0; i < 100; ++i) map.emplace_hint(map.end(), i, i * 2);
+  ASSERT_EQ(map.size(), (unsigned long)100);
+  ASSERT_EQ(map.at(42), 84);
+  int i = 0;
+  for (auto item : map) ASSERT_EQ(item.first, i++);
+}
+
+TEST(MapTest, MapEraseRangeRetention) {
+  s21::Map<int, int> map;
+  for (int t = 0; t < 1000; ++t) map.emplace_hint(map.end(), t, t);
+  ASSERT_EQ(map.erase_range(0, 600), (unsigned long)600);
+  ASSERT_EQ(map.size(), (unsigned long)400);
+  ASSERT_EQ((*map.begin()).first, 600);
+  map.erase(map.begin(), map.begin() + 100);
+  ASSERT_EQ((*map.begin()).first, 700);
+  map.insert(1000, 1);
+  ASSERT_EQ(map.size(), (unsigned long)301);
+}
+
+TEST(MapTest, MapSplitJoin) {
+  s21::Map<int, int> map({{1, 10}, {4, 40}, {2, 20}, {3, 30}});
+  s21::Map<int, int> upper = map.split(3);
+  ASSERT_EQ(map.size(), (unsigned long)2);
+  ASSERT_EQ(upper.size(), (unsigned long)2);
+  ASSERT_EQ(upper.at(4), 40);
+  map.join(upper);
+  ASSERT_EQ(map.size(), (unsigned long)4);
+  ASSERT_EQ(map.at(3), 30);
+}
+
+// Orders string keys ignoring case; only compares whole pairs.
+struct CaseInsensitivePairs {
+  using pair = std::pair<std::string, int>;
+  static bool Less(const std::string &a, const std::string &b) {
+    return std::lexicographical_compare(
+        a.begin(), a.end(), b.begin(), b.end(), [](char x, char y) {
+          return std::tolower((unsigned char)x) <
+                 std::tolower((unsigned char)y);
+        });
+  }
+  bool LessThan(const pair &a, const pair &b) const {
+    return Less(a.first, b.first);
+  }
+  bool GreaterThan(const pair &a, const pair &b) const {
+    return Less(b.first, a.first);
+  }
+  bool GreaterOrEquals(const pair &a, const pair &b) const {
+    return !Less(a.first, b.first);
+  }
+  bool NotEquals(const pair &a, const pair &b) const {
+    return Less(a.first, b.first) || Less(b.first, a.first);
+  }
+};
+
+TEST(MapTest, MapCustomComparatorRanges) {
+  s21::Map<std::string, int, CaseInsensitivePairs> map;
+  const char *keys[6] = {"b", "D", "a", "E", "c", "f"};
+  for (int i = 0; i < 6; ++i) map.insert(keys[i], i);
+  ASSERT_EQ(map.erase_range("B", "d"), (unsigned long)2);
+  ASSERT_EQ(map.erase_range("e", "A"), (unsigned long)0);
+  s21::Map<std::string, int, CaseInsensitivePairs> upper = map.split("E");
+  ASSERT_EQ(map.size(), (unsigned long)2);
+  ASSERT_EQ(upper.size(), (unsigned long)2);
+  ASSERT_EQ((*map.begin()).first, "a");
+  ASSERT_EQ((*upper.begin()).first, "E");
+}
+
+TEST(MapTest, MapRebalance) {
+  s21::Map<int, int> map;
+  for (int i = 0; i < 100; ++i) map.insert(i, i * i);
+  ASSERT_EQ(map.height(), 100u);
+  map.rebalance();
+  ASSERT_EQ(map.height(), 7u);
+  ASSERT_LT(map.average_depth(), 6.0);
+  int expected = 0;
+  for (auto it = map.begin(); it != map.end(); ++it, ++expected)
+    ASSERT_EQ((*it).second, expected * expected);
+  ASSERT_EQ(map.at(42), 1764);
+}
+
+TEST(MapTest, MapCompactNodes) {
+  s21::Map<int, std::string, s21::PairComparator<int, std::string>,
+           s21::CompactNodes>
+      map({{2, "two"}, {1, "one"}});
+  map[3] = "three";
+  map.insert_or_assign(1, "uno");
+  ASSERT_EQ(map.insert(2, "dos").second, false);
+  ASSERT_EQ(map.at(1), "uno");
+  ASSERT_EQ(map.at(2), "two");
+  ASSERT_EQ(map.at(3), "three");
+  ASSERT_THROW(map.at(4), std::out_of_range);
+  ASSERT_EQ(map.contains(3), true);
+  map.erase(map.find(2));
+  ASSERT_EQ(map.contains(2), false);
+  ASSERT_EQ(map.size(), 2u);
+  ASSERT_EQ((*map.begin()).second, "uno");
+  ASSERT_EQ((*(--map.end())).second, "three");
+  auto three = map.find(3);
+  for (int i = 10; i < 1000; ++i) map[i] = "many";
+  ASSERT_EQ((*three).second, "three");
+}
+
+TEST(MapTest, MapFreeze) {
+  s21::Map<int, std::string, s21::PairComparator<int, std::string>,
+           s21::CompactNodes>
+      map({{5, "five"}, {1, "one"}, {3, "three"}, {9, "nine"}});
+  s21::FrozenMap<int, std::string> frozen = map.freeze();
+  map.clear();
+  ASSERT_EQ(frozen.size(), 4u);
+  ASSERT_EQ(frozen.at(3), "three");
+  ASSERT_THROW(frozen.at(4), std::out_of_range);
+  ASSERT_EQ(frozen.lower_bound(6).value(), "nine");
+  ASSERT_EQ((*frozen.find(1)).second, "one");
+  std::string joined;
+  for (auto it = frozen.begin(); it != frozen.end(); ++it)
+    joined += std::to_string(it.key()) + it.value();
+  ASSERT_EQ(joined, "1one3three5five9nine");
+  s21::Map<int, double> plain({{2, 0.5}, {1, 0.25}});
+  s21::FrozenMap<int, double> small = plain.freeze();
+  ASSERT_EQ(small.at(2), 0.5);
+  ASSERT_EQ(small.begin().key(), 1);
+  s21::Map<std::string, int, CaseInsensitivePairs> named(
+      {{"b", 2}, {"C", 3}, {"a", 1}});
+  auto frozen_named = named.freeze();
+  ASSERT_EQ(frozen_named.at("B"), 2);
+  ASSERT_EQ(frozen_named.lower_bound("Bb").key(), "C");
+  ASSERT_EQ((*frozen_named.begin()).first, "a");
+}
+
 // S21_SET
 TEST(SetTest, SetBaseConstruct) {
   std::cout << "\n ============== TEST: S21_SET ============== \n" << std::endl;
@@ -381,6 +542,302 @@ TEST(SetTest, SetIter) {
   }
 }
 
+TEST(SetTest, SetInsertHint) {
+  s21::Set<int> set({10, 20, 30});
+  auto it = set.insert(set.begin(), 5);
+  ASSERT_EQ(*it, 5);
+  it = set.insert(set.find(20), 15);
+  ASSERT_EQ(*it, 15);
+  it = set.insert(set.find(20), 25);
+  ASSERT_EQ(*it, 25);
+  it = set.insert(set.begin(), 40);
+  ASSERT_EQ(*it, 40);
+  it = set.insert(set.end(), 20);
+  ASSERT_TRUE(it == set.find(20));
+  ASSERT_EQ(set.size(), (unsigned long)7);
+  int check[7] = {5, 10, 15, 20, 25, 30, 40};
+  int i = 0;
+  for (auto item : set) ASSERT_EQ(item, check[i++]);
+}
+
+TEST(SetTest, SetEmplaceHintSorted) {
+  s21::Set<int> set;
+  auto hint = set.end();
+  for (int i = 0; i < 1000; ++i) hint = set.emplace_hint(set.end(), i);
+  ASSERT_EQ(*hint, 999);
+  ASSERT_EQ(set.size(), (unsigned long)1000);
+  for (int i = 999; i >= 0; --i) hint = set.emplace_hint(hint, i);
+  ASSERT_EQ(set.size(), (unsigned long)1000);
+  int i = 0;
+  for (auto item : set) ASSERT_EQ(item, i++);
+  auto rit = set.end();
+  for (int j = 999; j >= 0; --j) ASSERT_EQ(*--rit, j);
+}
+
+TEST(SetTest, SetSplit) {
+  s21::Set<int> set({5, 1, 9, 3, 7, 2, 8});
+  s21::Set<int> upper = set.split(5);
+  ASSERT_EQ(set.size(), (unsigned long)3);
+  ASSERT_EQ(upper.size(), (unsigned long)4);
+  int low_check[3] = {1, 2, 3};
+  int high_check[4] = {5, 7, 8, 9};
+  int i = 0;
+  for (auto item : set) ASSERT_EQ(item, low_check[i++]);
+  i = 0;
+  for (auto item : upper) ASSERT_EQ(item, high_check[i++]);
+  ASSERT_EQ(*--set.end(), 3);
+  ASSERT_EQ(*--upper.end(), 9);
+  set.insert(4);
+  upper.insert(6);
+  ASSERT_EQ(set.contains(4), true);
+  ASSERT_EQ(upper.contains(6), true);
+}
+
+TEST(SetTest, SetSplitEdges) {
+  s21::Set<int> set({1, 2, 3});
+  s21::Set<int> all = set.split(0);
+  ASSERT_EQ(set.empty(), true);
+  ASSERT_EQ(all.size(), (unsigned long)3);
+  s21::Set<int> none = all.split(10);
+  ASSERT_EQ(none.empty(), true);
+  ASSERT_TRUE(none.begin() == none.end());
+  ASSERT_EQ(all.size(), (unsigned long)3);
+}
+
+TEST(SetTest, SetJoin) {
+  s21::Set<int> set({3, 1, 2});
+  s21::Set<int> set1({5, 4, 6});
+  set.join(set1);
+  ASSERT_EQ(set.size(), (unsigned long)6);
+  ASSERT_EQ(set1.size(), (unsigned long)0);
+  int i = 1;
+  for (auto item : set) ASSERT_EQ(item, i++);
+  ASSERT_EQ(*--set.end(), 6);
+  s21::Set<int> overlap({2, 10});
+  ASSERT_THROW(set.join(overlap), std::invalid_argument);
+  ASSERT_EQ(overlap.size(), (unsigned long)2);
+}
+
+TEST(SetTest, SetEraseRangeKeepsDepth) {
+  s21::Set<int> set;
+  uint32_t state = 7;
+  for (int i = 0; i < 4096; ++i) {
+    state = state * 1664525u + 1013904223u;
+    set.insert((int)(state >> 8));
+  }
+  size_t height = set.height();
+  for (int i = 0; i < 200; ++i) {
+    state = state * 1664525u + 1013904223u;
+    int lo = (int)(state >> 8);
+    set.erase_range(lo, lo + (1 << 14));
+    set.insert(lo);
+  }
+  ASSERT_LE(set.height(), height + 16);
+  s21::Set<int> upper = set.split(1 << 23);
+  size_t total = 0;
+  for (auto it = set.begin(); it != set.end(); ++it) ++total;
+  for (auto it = upper.begin(); it != upper.end(); ++it) ++total;
+  ASSERT_EQ(set.size() + upper.size(), total);
+}
+
+TEST(SetTest, SetEraseRange) {
+  s21::Set<int> set;
+  for (int i = 0; i < 100; ++i) set.insert((i * 37) % 100);
+  set.erase(set.find(10), set.find(90));
+  ASSERT_EQ(set.size(), (unsigned long)20);
+  ASSERT_EQ(set.erase_range(95, 1000), (unsigned long)5);
+  ASSERT_EQ(set.erase_range(0, 5), (unsigned long)5);
+  set.erase(set.find(92), set.end());
+  int check[7] = {5, 6, 7, 8, 9, 90, 91};
+  int i = 0;
+  for (auto item : set) ASSERT_EQ(item, check[i++]);
+  ASSERT_EQ(i, 7);
+  set.erase(set.begin(), set.end());
+  ASSERT_EQ(set.empty(), true);
+}
+
+TEST(SetTest, SetShapeAndRebalance) {
+  s21::Set<int> set;
+  ASSERT_EQ(set.height(), 0u);
+  ASSERT_EQ(set.average_depth(), 0.0);
+  set.rebalance();
+  for (int i = 0; i < 1000; ++i) set.insert(i);
+  ASSERT_EQ(set.height(), 1000u);
+  ASSERT_DOUBLE_EQ(set.average_depth(), 499.5);
+  auto middle = set.find(500);
+  set.rebalance();
+  ASSERT_EQ(set.height(), 10u);
+  s21::Vector<size_t> histogram = set.depth_histogram();
+  ASSERT_EQ(histogram.size(), 10u);
+  size_t total = 0;
+  for (size_t d = 0; d < histogram.size(); ++d) {
+    if (d < 9) {
+      ASSERT_EQ(histogram[d], size_t(1) << d);
+    }
+    total += histogram[d];
+  }
+  ASSERT_EQ(total, 1000u);
+  ASSERT_EQ(*middle, 500);
+  int expected = 0;
+  for (auto it = set.begin(); it != set.end(); ++it) ASSERT_EQ(*it, expected++);
+  ASSERT_EQ(expected, 1000);
+  ASSERT_EQ(*(--set.end()), 999);
+  set.insert(-1);
+  set.insert(1000);
+  set.erase(set.find(500));
+  ASSERT_EQ(*set.begin(), -1);
+  ASSERT_EQ(*(--set.end()), 1000);
+  ASSERT_EQ(set.contains(500), false);
+  ASSERT_EQ(set.contains(499), true);
+  ASSERT_EQ(set.size(), 1001u);
+}
+
+TEST(SetTest, SetCompact) {
+  size_t blocks = s21::arena::LiveBlocks();
+  s21::Set<int> set;
+  for (int i = 0; i < 200; ++i) set.insert((i * 37) % 200);
+  for (int i = 0; i < 200; i += 3) set.erase(set.find(i));
+  set.compact();
+  ASSERT_EQ(s21::arena::LiveBlocks(), blocks + 1);
+  ASSERT_EQ(set.size(), 133u);
+  int count = 0;
+  int prev = -1;
+  for (auto it = set.begin(); it != set.end(); ++it, ++count) {
+    ASSERT_GT(*it, prev);
+    ASSERT_NE(*it % 3, 0);
+    prev = *it;
+  }
+  ASSERT_EQ(count, 133);
+  ASSERT_EQ(*(--set.end()), 199);
+  ASSERT_EQ(set.contains(100), true);
+  set.insert(0);
+  ASSERT_EQ(*set.begin(), 0);
+  s21::Set<int> other({-1, 3});
+  other.merge(set);
+  ASSERT_EQ(other.size(), 136u);
+  set.clear();
+  other.compact();
+  ASSERT_EQ(other.size(), 136u);
+  ASSERT_EQ(*other.begin(), -1);
+  s21::Map<int, double> map({{2, 2.5}, {1, 1.5}, {3, 3.5}});
+  map.compact();
+  ASSERT_EQ(map.at(3), 3.5);
+  map.erase(map.begin());
+  ASSERT_EQ((*map.begin()).second, 2.5);
+  other.clear();
+  map.clear();
+  ASSERT_EQ(s21::arena::LiveBlocks(), blocks);
+}
+
+TEST(SetTest, SetCompactNodes) {
+  using CompactSet =
+      s21::Set<int, s21::SingleComparator<int>, s21::CompactNodes>;
+  CompactSet set;
+  ASSERT_TRUE(set.begin() == set.end());
+  ASSERT_EQ(set.max_size(), (size_t)UINT32_MAX - 1);
+  std::set<int> expected;
+  for (int i = 0; i < 2000; ++i) {
+    int key = (i * 7919) % 1000;
+    ASSERT_EQ(set.insert(key).second, expected.insert(key).second);
+  }
+  for (int i = 0; i < 1000; i += 3) {
+    set.erase(set.find(i));
+    expected.erase(i);
+  }
+  ASSERT_EQ(set.size(), expected.size());
+  auto it = set.begin();
+  for (int key : expected) ASSERT_EQ(*it++, key);
+  ASSERT_TRUE(it == set.end());
+  ASSERT_EQ(*(--set.end()), 998);
+  ASSERT_EQ(set.contains(3), false);
+  ASSERT_EQ(set.contains(4), true);
+  size_t memory = set.memory_usage();
+  for (int i = 0; i < 1000; i += 3) set.insert(i);
+  ASSERT_EQ(set.memory_usage(), memory);
+  ASSERT_EQ(set.size(), 1000u);
+  CompactSet other({-5, 0, 5000});
+  other.merge(set);
+  ASSERT_EQ(other.size(), 1002u);
+  ASSERT_EQ(set.size(), 1u);
+  ASSERT_EQ(*set.begin(), 0);
+  CompactSet copy(other);
+  ASSERT_EQ(*copy.begin(), -5);
+  using ConstIt = CompactSet::const_iterator;
+  static_assert(std::is_same<decltype(*ConstIt()), const int&>::value, "");
+  static_assert(!std::is_convertible<ConstIt, CompactSet::iterator>::value,
+                "");
+  const CompactSet& view = copy;
+  ConstIt first = copy.begin();
+  ASSERT_TRUE(first == view.cbegin());
+  int previous = *view.cbegin() - 1;
+  for (auto cit = view.cbegin(); cit != view.cend(); ++cit) {
+    ASSERT_LT(previous, *cit);
+    previous = *cit;
+  }
+  ASSERT_EQ(*(--view.cend()), 5000);
+  ASSERT_EQ(*(--copy.end()), 5000);
+  copy.clear();
+  ASSERT_EQ(copy.empty(), true);
+  ASSERT_EQ(other.size(), 1002u);
+}
+
+TEST(SetTest, SetFreeze) {
+  for (int n = 0; n < 40; ++n) {
+    s21::Set<int> set;
+    for (int i = 0; i < n; ++i) set.insert(i * 2);
+    s21::FrozenSet<int> frozen = set.freeze();
+    ASSERT_EQ(frozen.size(), (size_t)n);
+    int expected = 0;
+    for (auto it = frozen.begin(); it != frozen.end(); ++it, expected += 2)
+      ASSERT_EQ(*it, expected);
+    ASSERT_EQ(expected, 2 * n);
+    for (int key = -1; key <= 2 * n; ++key) {
+      ASSERT_EQ(frozen.contains(key), key >= 0 && key < 2 * n && key % 2 == 0);
+      auto lower = frozen.lower_bound(key);
+      if (key >= 2 * n - 1) {
+        ASSERT_TRUE(lower == frozen.end());
+      } else {
+        ASSERT_EQ(*lower, key < 0 ? 0 : (key + 1) / 2 * 2);
+      }
+    }
+    if (n) {
+      ASSERT_EQ(*(--frozen.end()), 2 * n - 2);
+      ASSERT_EQ(*frozen.find(2 * n - 2), 2 * n - 2);
+      auto it = frozen.end();
+      for (int i = n - 1; i >= 0; --i) ASSERT_EQ(*--it, 2 * i);
+      ASSERT_TRUE(it == frozen.begin());
+    }
+    ASSERT_TRUE(frozen.find(1) == frozen.end());
+  }
+}
+
+TEST(SetTest, SetCompactedNodesMoveBetweenContainers) {
+  size_t blocks = s21::arena::LiveBlocks();
+  s21::Set<int> set;
+  for (int i = 0; i < 1000; ++i) set.insert((i * 7919) % 1000);
+  set.compact();
+  s21::Set<int> upper = set.split(500);
+  s21::Set<int> moved(std::move(upper));
+  std::thread other([&moved] {
+    for (int i = 500; i < 1000; i += 2) moved.erase(moved.find(i));
+  });
+  for (int i = 0; i < 500; i += 2) set.erase(set.find(i));
+  other.join();
+  ASSERT_EQ(s21::arena::LiveBlocks(), blocks + 1);
+  set.join(moved);
+  ASSERT_EQ(set.size(), 500u);
+  s21::Multiset<int> bag({1, 1, 2});
+  bag.compact();
+  s21::Multiset<int> into;
+  into.merge(bag);
+  ASSERT_EQ(into.count(1), 2u);
+  set.compact();
+  set.clear();
+  ASSERT_EQ(s21::arena::LiveBlocks(), blocks + 1);
+  into.clear();
+  ASSERT_EQ(s21::arena::LiveBlocks(), blocks);
+}
+
 // S21_VECTOR
 TEST(VectorTest, VecBaseConstruct) {
   std::cout << "\n ============== TEST: S21_VECTOR ============== \n"
@@ -540,6 +997,177 @@ TEST(VectorTest, VecErase) {
   ASSERT_EQ(Vec.size(), (unsigned long)4);
 }
 
+TEST(VectorTest, VecPushBackEmpty) {
+  s21::Vector<int> vec;
+  for (int i = 0; i < 10; ++i) vec.push_back(i);
+  ASSERT_EQ(vec.size(), (unsigned long)10);
+  ASSERT_EQ(vec[9], 9);
+}
+
+TEST(VectorTest, VecSimdKernels) {
+  s21::simd::Level top = s21::simd::DetectLevel();
+  for (size_t n : {1, 3, 8, 13, 64, 1001}) {
+    s21::Vector<int32_t> ints(n);
+    s21::Vector<float> floats(n);
+    for (size_t i = 0; i < n; ++i) {
+      ints[i] = (int32_t)((i * 2654435761u) % 2001) - 1000;
+      floats[i] = (float)ints[i] / 4;
+    }
+    int32_t needle = ints[n - 1];
+    for (int level = 0; level <= (int)top; ++level) {
+      auto lvl = (s21::simd::Level)level;
+      ASSERT_EQ(s21::simd::Find(ints.data(), n, needle, lvl),
+                s21::simd::FindScalar(ints.data(), n, needle));
+      ASSERT_EQ(s21::simd::Find(ints.data(), n, 5000, lvl), n);
+      ASSERT_EQ(s21::simd::Count(ints.data(), n, needle, lvl),
+                s21::simd::CountScalar(ints.data(), n, needle));
+      ASSERT_EQ(s21::simd::MinMax<false>(ints.data(), n, lvl),
+                *std::min_element(ints.data(), ints.data() + n));
+      ASSERT_EQ(s21::simd::MinMax<true>(ints.data(), n, lvl),
+                *std::max_element(ints.data(), ints.data() + n));
+      ASSERT_EQ(s21::simd::Sum(ints.data(), n, lvl),
+                s21::simd::SumScalar(ints.data(), n));
+      ASSERT_EQ(s21::simd::Find(floats.data(), n, floats[n / 2], lvl),
+                s21::simd::FindScalar(floats.data(), n, floats[n / 2]));
+      ASSERT_EQ(s21::simd::Count(floats.data(), n, floats[0], lvl),
+                s21::simd::CountScalar(floats.data(), n, floats[0]));
+      ASSERT_EQ(s21::simd::MinMax<false>(floats.data(), n, lvl),
+                *std::min_element(floats.data(), floats.data() + n));
+      ASSERT_EQ(s21::simd::MinMax<true>(floats.data(), n, lvl),
+                *std::max_element(floats.data(), floats.data() + n));
+      ASSERT_DOUBLE_EQ(s21::simd::Sum(floats.data(), n, lvl),
+                       s21::simd::SumScalar(floats.data(), n));
+    }
+  }
+}
+
+TEST(VectorTest, VecSimdAlgorithms) {
+  s21::Vector<int32_t> vec({4, -7, 12, 4, 0, 9, 4, 3, 11, -2});
+  ASSERT_EQ(*s21::find(vec, 12), 12);
+  ASSERT_TRUE(s21::find(vec, 100) == vec.end());
+  ASSERT_EQ(s21::contains(vec, -2), true);
+  ASSERT_EQ(s21::contains(vec, 5), false);
+  ASSERT_EQ(s21::count(vec, 4), (unsigned long)3);
+  ASSERT_EQ(s21::min(vec), -7);
+  ASSERT_EQ(s21::max(vec), 12);
+  ASSERT_EQ(s21::sum(vec), 38);
+  s21::Vector<float> floats({1.5f, -2.0f, 8.25f});
+  ASSERT_EQ(s21::max(floats), 8.25f);
+  ASSERT_DOUBLE_EQ(s21::sum(floats), 7.75);
+  s21::Vector<int32_t> empty;
+  ASSERT_THROW(s21::min(empty), std::out_of_range);
+  ASSERT_EQ(s21::sum(empty), 0);
+}
+
+TEST(VectorTest, VecParallelSort) {
+  for (unsigned threads : {1u, 3u, 4u, 7u}) {
+    s21::Vector<int> vec(200003);
+    for (size_t i = 0; i < vec.size(); ++i)
+      vec[i] = (int)((i * 2654435761u) % 100000);
+    std::vector<int> expected(vec.data(), vec.data() + vec.size());
+    std::sort(expected.begin(), expected.end());
+    s21::sort(s21::execution::parallel_policy{threads}, vec);
+    for (size_t i = 0; i < vec.size(); ++i) ASSERT_EQ(vec[i], expected[i]);
+  }
+  s21::Vector<int> small({5, 3, 9, 1});
+  s21::sort(s21::execution::par, small, std::greater<int>());
+  ASSERT_EQ(small[0], 9);
+  ASSERT_EQ(small[3], 1);
+}
+
+TEST(VectorTest, VecParallelStableSort) {
+  s21::Vector<std::pair<int, int>> vec;
+  for (int i = 0; i < 150000; ++i) vec.push_back({(i * 7919) % 100, i});
+  auto by_key = [](const std::pair<int, int> &a, const std::pair<int, int> &b) {
+    return a.first < b.first;
+  };
+  s21::stable_sort(s21::execution::parallel_policy{5}, vec, by_key);
+  for (size_t i = 1; i < vec.size(); ++i) {
+    ASSERT_LE(vec[i - 1].first, vec[i].first);
+    if (vec[i - 1].first == vec[i].first) {
+      ASSERT_LT(vec[i - 1].second, vec[i].second);
+    }
+  }
+}
+
+TEST(VectorTest, VecParallelAlgorithms) {
+  s21::Vector<int> vec(100000);
+  for (size_t i = 0; i < vec.size(); ++i) vec[i] = (int)i;
+  s21::for_each(s21::execution::parallel_policy{4}, vec, [](int &x) { ++x; });
+  ASSERT_EQ(vec[0], 1);
+  ASSERT_EQ(vec[99999], 100000);
+  s21::Vector<long long> squares(vec.size());
+  s21::transform(s21::execution::par, vec, squares,
+                 [](int x) { return (long long)x * x; });
+  ASSERT_EQ(squares[99999], 10000000000LL);
+  long long total = s21::reduce(s21::execution::parallel_policy{4}, vec, 0LL);
+  ASSERT_EQ(total, 5000050000LL);
+  ASSERT_EQ(s21::reduce(vec, 0LL), total);
+  s21::Vector<long long> too_small(10);
+  ASSERT_THROW(s21::transform(vec, too_small, [](int x) { return x; }),
+               std::out_of_range);
+}
+
+// Has no default constructor.
+struct Total {
+  long long value;
+  Total(long long v) : value(v) {}
+};
+
+TEST(VectorTest, VecParallelReduceNoDefault) {
+  s21::Vector<int> vec(1 << 16);
+  for (size_t i = 0; i < vec.size(); ++i) vec[i] = (int)(i % 10);
+  auto add = [](Total a, Total b) { return Total(a.value + b.value); };
+  Total total =
+      s21::reduce(s21::execution::parallel_policy{4}, vec, Total(5), add);
+  ASSERT_EQ(total.value, 5 + s21::reduce(vec, 0LL));
+}
+
+TEST(VectorTest, VecRadixSortIntegers) {
+  s21::Vector<int64_t> vec(100001);
+  for (size_t i = 0; i < vec.size(); ++i)
+    vec[i] = (int64_t)(i * 0x9E3779B97F4A7C15ull);
+  std::vector<int64_t> expected(vec.data(), vec.data() + vec.size());
+  std::sort(expected.begin(), expected.end());
+  s21::radix_sort(vec);
+  for (size_t i = 0; i < vec.size(); ++i) ASSERT_EQ(vec[i], expected[i]);
+  s21::Vector<uint16_t> small({300, 2, 65535, 0, 2});
+  s21::radix_sort(small);
+  ASSERT_EQ(small[0], 0);
+  ASSERT_EQ(small[2], 2);
+  ASSERT_EQ(small[4], 65535);
+  s21::Vector<int8_t> bytes({-1, 127, -128, 0});
+  s21::radix_sort(bytes);
+  ASSERT_EQ(bytes[0], -128);
+  ASSERT_EQ(bytes[3], 127);
+}
+
+TEST(VectorTest, VecRadixSortFloats) {
+  s21::Vector<double> vec({3.5, -0.25, 0.0, -1e300, 1e-300, -7.0, 42.0});
+  s21::radix_sort(vec);
+  ASSERT_TRUE(std::is_sorted(vec.data(), vec.data() + vec.size()));
+  ASSERT_EQ(vec[0], -1e300);
+  ASSERT_EQ(vec[6], 42.0);
+  s21::Vector<float> same({1.5f, 1.5f, 1.5f});
+  s21::radix_sort(same);
+  ASSERT_EQ(same[2], 1.5f);
+}
+
+TEST(VectorTest, VecRadixSortByKey) {
+  s21::Vector<std::pair<uint32_t, int>> vec;
+  for (int i = 0; i < 50000; ++i)
+    vec.push_back({(uint32_t)((i * 7919) % 1000), i});
+  s21::radix_sort(vec, [](const std::pair<uint32_t, int> &p) {
+    return p.first;
+  });
+  for (size_t i = 1; i < vec.size(); ++i) {
+    ASSERT_LE(vec[i - 1].first, vec[i].first);
+    if (vec[i - 1].first == vec[i].first) {
+      ASSERT_LT(vec[i - 1].second, vec[i].second);
+    }
+  }
+}
+
 // S21_LIST
 TEST(tests_of_list, push_back) {
   s21::List<int> Mylist_1 = {1};
@@ -746,6 +1374,35 @@ TEST(tests_of_List, insert) {
   ASSERT_EQ(*it_std_2, *it_2);
 }
 
+TEST(ListTest, ListCompact) {
+  size_t blocks = s21::arena::LiveBlocks();
+  s21::List<int> list;
+  for (int i = 0; i < 100; ++i) list.push_back(i);
+  for (int i = 0; i < 50; ++i) list.pop_front();
+  for (int i = 0; i < 50; ++i) list.push_front(-i);
+  list.compact();
+  ASSERT_EQ(s21::arena::LiveBlocks(), blocks + 1);
+  ASSERT_EQ(list.size(), 100u);
+  ASSERT_EQ(list.front(), -49);
+  ASSERT_EQ(list.back(), 99);
+  auto it = list.begin();
+  const char *first = (const char *)&*it;
+  const char *second = (const char *)&*(++it);
+  for (int i = 1; it != list.end(); ++it, ++i) {
+    ASSERT_EQ((const char *)&*it, first + i * (second - first));
+  }
+  s21::List<int> other({1000, 1001});
+  other.splice(other.cbegin(), list);
+  ASSERT_EQ(other.size(), 102u);
+  list.push_back(7);
+  list.compact();
+  other.erase(other.begin());
+  other.clear();
+  ASSERT_EQ(list.front(), 7);
+  list.clear();
+  ASSERT_EQ(s21::arena::LiveBlocks(), blocks);
+}
+
 // S21_QUEUEU
 TEST(tests_of_queue, push_1) {
   s21::Queue<int> Myqueue_1;
@@ -887,6 +1544,1508 @@ TEST(tests_of_stack, equal) {
   }
 }
 
+// S21_MULTISET
+TEST(MultisetTest, MultisetListConstruct) {
+  std::cout << "\n ============== TEST: S21_MULTISET ============== \n"
+            << std::endl;
+  s21::Multiset<int> set({3, 1, 2, 3, 1, 3});
+  ASSERT_EQ(set.size(), (unsigned long)6);
+  int check[6] = {1, 1, 2, 3, 3, 3};
+  int i = 0;
+  for (auto item : set) ASSERT_EQ(item, check[i++]);
+}
+
+TEST(MultisetTest, MultisetCount) {
+  s21::Multiset<int> set({5, 1, 5, 2, 5});
+  ASSERT_EQ(set.count(5), (unsigned long)3);
+  ASSERT_EQ(set.count(2), (unsigned long)1);
+  ASSERT_EQ(set.count(7), (unsigned long)0);
+  ASSERT_EQ(set.contains(1), true);
+  ASSERT_EQ(set.contains(4), false);
+}
+
+TEST(MultisetTest, MultisetEqualRange) {
+  s21::Multiset<int> set({4, 2, 4, 8, 4, 1});
+  auto range = set.equal_range(4);
+  int count = 0;
+  for (auto it = range.first; it != range.second; ++it) {
+    ASSERT_EQ(*it, 4);
+    ++count;
+  }
+  ASSERT_EQ(count, 3);
+  ASSERT_EQ(*range.second, 8);
+  ASSERT_TRUE(set.lower_bound(3) == set.find(4));
+  ASSERT_EQ(*set.upper_bound(1), 2);
+  ASSERT_TRUE(set.upper_bound(8) == set.end());
+}
+
+TEST(MultisetTest, MultisetEraseKey) {
+  s21::Multiset<int> set({7, 3, 7, 9, 7, 1, 7});
+  ASSERT_EQ(set.erase(7), (unsigned long)4);
+  ASSERT_EQ(set.erase(7), (unsigned long)0);
+  ASSERT_EQ(set.size(), (unsigned long)3);
+  int check[3] = {1, 3, 9};
+  int i = 0;
+  for (auto item : set) ASSERT_EQ(item, check[i++]);
+}
+
+TEST(MultisetTest, MultisetEraseIterator) {
+  s21::Multiset<int> set({2, 2, 2});
+  set.erase(set.begin() + 1);
+  ASSERT_EQ(set.size(), (unsigned long)2);
+  ASSERT_EQ(set.count(2), (unsigned long)2);
+  set.erase(set.begin());
+  set.erase(set.begin());
+  ASSERT_EQ(set.empty(), true);
+}
+
+TEST(MultisetTest, MultisetMerge) {
+  s21::Multiset<int> set({1, 2, 3});
+  s21::Multiset<int> set1({2, 3, 4});
+  set.merge(set1);
+  ASSERT_EQ(set.size(), (unsigned long)6);
+  ASSERT_EQ(set1.size(), (unsigned long)0);
+  ASSERT_EQ(set.count(2), (unsigned long)2);
+  ASSERT_EQ(set.count(3), (unsigned long)2);
+}
+
+TEST(MultisetTest, MultisetCopyMove) {
+  s21::Multiset<int> set({1, 1, 2});
+  s21::Multiset<int> set1(set);
+  s21::Multiset<int> set2(std::move(set));
+  ASSERT_EQ(set1.count(1), (unsigned long)2);
+  ASSERT_EQ(set2.count(1), (unsigned long)2);
+  ASSERT_EQ(set.size(), (unsigned long)0);
+}
+
+// S21_MULTIMAP
+TEST(MultimapTest, MultimapStableOrder) {
+  std::cout << "\n ============== TEST: S21_MULTIMAP ============== \n"
+            << std::endl;
+  s21::Multimap<int, int> map;
+  map.insert(2, 10);
+  map.insert(1, 5);
+  map.insert(2, 20);
+  map.insert(3, 1);
+  map.insert(2, 30);
+  map.emplace(2, 40);
+  ASSERT_EQ(map.size(), (unsigned long)6);
+  ASSERT_EQ(map.count(2), (unsigned long)4);
+  auto range = map.equal_range(2);
+  int check[4] = {10, 20, 30, 40};
+  int i = 0;
+  for (auto it = range.first; it != range.second; ++it)
+    ASSERT_EQ((*it).second, check[i++]);
+  ASSERT_EQ(i, 4);
+}
+
+TEST(MultimapTest, MultimapStableOrderAfterErase) {
+  s21::Multimap<int, int> map({{5, 0}, {1, 1}, {5, 1}, {9, 0}, {5, 2}});
+  map.erase(map.find(5));
+  auto range = map.equal_range(5);
+  ASSERT_EQ((*range.first).second, 1);
+  ASSERT_EQ((*++range.first).second, 2);
+  ASSERT_EQ(map.count(5), (unsigned long)2);
+}
+
+TEST(MultimapTest, MultimapEraseKey) {
+  s21::Multimap<int, int> map({{1, 1}, {2, 1}, {2, 2}, {3, 1}, {2, 3}});
+  ASSERT_EQ(map.erase(2), (unsigned long)3);
+  ASSERT_EQ(map.size(), (unsigned long)2);
+  ASSERT_EQ(map.contains(2), false);
+  ASSERT_EQ(map.contains(3), true);
+  ASSERT_TRUE(map.find(2) == map.end());
+}
+
+TEST(MultimapTest, MultimapMerge) {
+  s21::Multimap<int, int> map({{1, 1}, {2, 1}});
+  s21::Multimap<int, int> map1({{2, 2}, {3, 1}});
+  map.merge(map1);
+  ASSERT_EQ(map.size(), (unsigned long)4);
+  ASSERT_EQ(map1.empty(), true);
+  auto range = map.equal_range(2);
+  ASSERT_EQ((*range.first).second, 1);
+  ASSERT_EQ((*++range.first).second, 2);
+}
+
+TEST(MultimapTest, MultimapCustomEquivalence) {
+  s21::Multimap<std::string, int, CaseInsensitivePairs> map;
+  map.insert("Apple", 1);
+  map.insert("pear", 2);
+  map.insert("APPLE", 3);
+  map.insert("apple", 4);
+  ASSERT_EQ(map.count("aPPle"), (unsigned long)3);
+  ASSERT_EQ((*map.find("PEAR")).second, 2);
+  ASSERT_EQ(map.contains("plum"), false);
+  auto range = map.equal_range("apple");
+  int check[3] = {1, 3, 4};
+  int i = 0;
+  for (auto it = range.first; it != range.second; ++it)
+    ASSERT_EQ((*it).second, check[i++]);
+  ASSERT_EQ(i, 3);
+  ASSERT_EQ(map.erase("APPLE"), (unsigned long)3);
+  ASSERT_EQ(map.size(), (unsigned long)1);
+}
+
+// S21_SMALLVECTOR
+TEST(SmallVectorTest, SmallVecInline) {
+  std::cout << "\n ============== TEST: S21_SMALLVECTOR ============== \n"
+            << std::endl;
+  s21::SmallVector<int, 4> vec;
+  ASSERT_EQ(vec.capacity(), (unsigned long)4);
+  for (int i = 0; i < 4; ++i) vec.push_back(i);
+  ASSERT_EQ(vec.is_inline(), true);
+  vec.push_back(4);
+  ASSERT_EQ(vec.is_inline(), false);
+  ASSERT_EQ(vec.size(), (unsigned long)5);
+  for (int i = 0; i < 5; ++i) ASSERT_EQ(vec[i], i);
+  vec.pop_back();
+  vec.shrink_to_fit();
+  ASSERT_EQ(vec.is_inline(), true);
+  ASSERT_EQ(vec.back(), 3);
+}
+
+TEST(SmallVectorTest, SmallVecConstruct) {
+  s21::SmallVector<int, 2> vec({1, 2, 3});
+  s21::SmallVector<int, 2> copy(vec);
+  s21::SmallVector<int, 2> sized(2);
+  ASSERT_EQ(copy.size(), (unsigned long)3);
+  ASSERT_EQ(copy.at(2), 3);
+  ASSERT_EQ(sized.size(), (unsigned long)2);
+  ASSERT_EQ(sized[1], 0);
+  const s21::SmallVector<int, 2> &view = copy;
+  ASSERT_EQ(view.front(), 1);
+  ASSERT_EQ(view.back(), 3);
+  s21::SmallVector<int, 2> moved(std::move(vec));
+  ASSERT_EQ(moved.size(), (unsigned long)3);
+  ASSERT_EQ(vec.size(), (unsigned long)0);
+  ASSERT_THROW(moved.at(3), std::out_of_range);
+  s21::SmallVector<int, 2> small({7});
+  s21::SmallVector<int, 2> small_moved(std::move(small));
+  ASSERT_EQ(small_moved.front(), 7);
+  ASSERT_EQ(small_moved.is_inline(), true);
+}
+
+TEST(SmallVectorTest, SmallVecInsertErase) {
+  s21::SmallVector<int, 4> vec({1, 3});
+  auto it = vec.insert(vec.begin() + 1, 2);
+  ASSERT_EQ(*it, 2);
+  vec.insert(vec.begin(), 0);
+  vec.insert(vec.end(), 4);
+  ASSERT_EQ(vec.size(), (unsigned long)5);
+  for (int i = 0; i < 5; ++i) ASSERT_EQ(vec[i], i);
+  vec.erase(vec.begin());
+  vec.erase(vec.begin() + 2);
+  int check[3] = {1, 2, 4};
+  int i = 0;
+  for (auto item : vec) ASSERT_EQ(item, check[i++]);
+}
+
+TEST(SmallVectorTest, SmallVecSwap) {
+  s21::SmallVector<std::string, 2> a({"a"});
+  s21::SmallVector<std::string, 2> b({"b", "c", "d"});
+  a.swap(b);
+  ASSERT_EQ(a.size(), (unsigned long)3);
+  ASSERT_EQ(a[2], "d");
+  ASSERT_EQ(b.size(), (unsigned long)1);
+  ASSERT_EQ(b[0], "a");
+  s21::SmallVector<std::string, 2> c({"x", "y", "z"});
+  a.swap(c);
+  ASSERT_EQ(a[0], "x");
+  ASSERT_EQ(c[0], "b");
+  b.swap(b);
+  ASSERT_EQ(b[0], "a");
+  a = b;
+  ASSERT_EQ(a.size(), (unsigned long)1);
+  ASSERT_EQ(a.is_inline(), false);
+  a.clear();
+  ASSERT_EQ(a.empty(), true);
+}
+
+// S21_PRIORITY_QUEUE
+TEST(PriorityQueueTest, PQueuePushPop) {
+  std::cout << "\n ============== TEST: S21_PRIORITY_QUEUE ============== \n"
+            << std::endl;
+  s21::PriorityQueue<int> pq;
+  ASSERT_EQ(pq.empty(), true);
+  std::vector<int> values;
+  for (int i = 0; i < 1000; ++i) values.push_back((i * 7919) % 1009);
+  for (int value : values) pq.push(value);
+  ASSERT_EQ(pq.size(), (unsigned long)1000);
+  std::sort(values.rbegin(), values.rend());
+  for (int value : values) {
+    ASSERT_EQ(pq.top(), value);
+    pq.pop();
+  }
+  ASSERT_EQ(pq.empty(), true);
+}
+
+TEST(PriorityQueueTest, PQueueHeapify) {
+  s21::PriorityQueue<int> pq({4, 9, 1, 7, 3, 9, 0});
+  ASSERT_EQ(pq.top(), 9);
+  pq.pop();
+  ASSERT_EQ(pq.top(), 9);
+  pq.pop();
+  ASSERT_EQ(pq.top(), 7);
+  std::vector<int> more = {8, 2, 10};
+  pq.push_range(more.begin(), more.end());
+  ASSERT_EQ(pq.size(), (unsigned long)8);
+  ASSERT_EQ(pq.top(), 10);
+  std::vector<int> many(100);
+  std::iota(many.begin(), many.end(), 20);
+  pq.push_range(many.begin(), many.end());
+  ASSERT_EQ(pq.top(), 119);
+  int prev = pq.top();
+  while (!pq.empty()) {
+    ASSERT_LE(pq.top(), prev);
+    prev = pq.top();
+    pq.pop();
+  }
+}
+
+TEST(PriorityQueueTest, PQueueArityAndCompare) {
+  struct MinFirst : s21::SingleComparator<std::pair<int, std::string>> {
+    bool LessThan(const type &a, const type &b) const {
+      return a.first > b.first;
+    }
+  };
+  s21::PriorityQueue<std::pair<int, std::string>,
+                     s21::Vector<std::pair<int, std::string>>, MinFirst, 2>
+      pq;
+  pq.emplace(5, "five");
+  pq.emplace(1, "one");
+  pq.emplace(3, "three");
+  ASSERT_EQ(pq.top().second, "one");
+  s21::PriorityQueue<std::pair<int, std::string>,
+                     s21::Vector<std::pair<int, std::string>>, MinFirst, 2>
+      copy(pq);
+  pq.pop();
+  ASSERT_EQ(pq.top().second, "three");
+  ASSERT_EQ(copy.top().second, "one");
+  ASSERT_EQ(copy.size(), (unsigned long)3);
+  s21::PriorityQueue<int, s21::Vector<int>, s21::SingleComparator<int>, 8>
+      wide({3, 1, 2});
+  s21::PriorityQueue<int, s21::Vector<int>, s21::SingleComparator<int>, 8>
+      moved(std::move(wide));
+  ASSERT_EQ(moved.top(), 3);
+  ASSERT_EQ(wide.empty(), true);
+}
+
+// S21_INSTRUMENTATION
+TEST(InstrumentationTest, InstrumentTree) {
+  std::cout << "\n ============== TEST: S21_INSTRUMENTATION ============== \n"
+            << std::endl;
+  namespace ins = s21::instrumentation;
+  ins::Counters before = ins::ThreadCounters();
+  s21::Set<int> set;
+  for (int i = 0; i < 100; ++i) set.insert(i);
+  set.insert(50);
+  set.find(0);
+  set.erase(set.find(99));
+  ins::Counters after = ins::ThreadCounters();
+  ASSERT_EQ(after[ins::tree_inserts] - before[ins::tree_inserts], 100u);
+  ASSERT_EQ(after[ins::tree_node_allocations] -
+                before[ins::tree_node_allocations],
+            101u);
+  ASSERT_EQ(after[ins::tree_erases] - before[ins::tree_erases], 1u);
+  ASSERT_GE(after[ins::tree_max_search_depth], 99u);
+  ASSERT_GT(after[ins::tree_search_steps], before[ins::tree_search_steps]);
+  set.clear();
+  ASSERT_EQ(ins::ThreadCounters()[ins::tree_node_frees] -
+                before[ins::tree_node_frees],
+            101u);
+}
+
+TEST(InstrumentationTest, InstrumentSequences) {
+  namespace ins = s21::instrumentation;
+  ins::Counters before = ins::ThreadCounters();
+  s21::Vector<int> vec;
+  for (int i = 0; i < 5; ++i) vec.push_back(i);
+  s21::List<int> list;
+  list.push_back(1);
+  list.push_front(0);
+  list.pop_back();
+  ins::Counters after = ins::ThreadCounters();
+  ASSERT_EQ(after[ins::vector_growths] - before[ins::vector_growths], 4u);
+  ASSERT_EQ(after[ins::vector_bytes_allocated] -
+                before[ins::vector_bytes_allocated],
+            (1u + 2u + 4u + 8u) * sizeof(int));
+  ASSERT_EQ(after[ins::list_inserts] - before[ins::list_inserts], 2u);
+  ASSERT_EQ(after[ins::list_erases] - before[ins::list_erases], 1u);
+}
+
+TEST(InstrumentationTest, InstrumentRegistry) {
+  namespace ins = s21::instrumentation;
+  ins::Reset();
+  std::thread worker([] {
+    s21::Set<int> set({3, 1, 2});
+    ASSERT_EQ(ins::ThreadCounters()[ins::tree_inserts], 3u);
+  });
+  worker.join();
+  s21::List<int> list({1, 2});
+  ins::Counters total = ins::Snapshot();
+  ASSERT_EQ(total[ins::tree_inserts], 3u);
+  ASSERT_EQ(total[ins::list_inserts], 2u);
+  std::string json = ins::DumpJson();
+  ASSERT_NE(json.find("\"tree_inserts\": 3"), std::string::npos);
+  ASSERT_EQ(json.front(), '{');
+  ASSERT_EQ(json.back(), '}');
+  ins::Reset();
+  ASSERT_EQ(ins::Snapshot()[ins::list_inserts], 0u);
+}
+
+// S21_SNAPSHOT
+TEST(SnapshotTest, VectorRoundTrip) {
+  std::cout << "\n ============== TEST: S21_SNAPSHOT ============== \n"
+            << std::endl;
+  std::string path = ::testing::TempDir() + "s21_vector.snap";
+  s21::Vector<int> v = {5, 1, 4, 2};
+  v.save(path);
+  s21::Vector<int> loaded = {7};
+  loaded.load(path);
+  ASSERT_EQ(loaded.size(), 4u);
+  for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(loaded[i], v[i]);
+  s21::MappedVector<int> mapped(path);
+  ASSERT_EQ(mapped.size(), 4u);
+  ASSERT_EQ(mapped[2], 4);
+  ASSERT_THROW(mapped.at(4), std::out_of_range);
+  std::remove(path.c_str());
+}
+
+TEST(SnapshotTest, StreamedVector) {
+  std::string path = ::testing::TempDir() + "s21_strings.snap";
+  s21::Vector<std::string> v = {"", "alpha", std::string(1000, 'x')};
+  v.save(path);
+  s21::Vector<std::string> loaded;
+  loaded.load(path);
+  ASSERT_EQ(loaded.size(), 3u);
+  for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(loaded[i], v[i]);
+  ASSERT_THROW(s21::MappedVector<int>{path}, std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(SnapshotTest, SetRoundTrip) {
+  std::string path = ::testing::TempDir() + "s21_set.snap";
+  s21::Set<int> set;
+  for (int i = 0; i < 1000; ++i) set.insert((i * 7919) % 1000 * 2);
+  set.save(path);
+  s21::Set<int> loaded = {-1};
+  loaded.load(path);
+  ASSERT_EQ(loaded.size(), 1000u);
+  ASSERT_EQ(loaded.contains(-1), false);
+  ASSERT_LE(loaded.height(), 10u);
+  auto it = loaded.begin();
+  for (auto jt = set.begin(); jt != set.end(); ++jt, ++it)
+    ASSERT_EQ(*it, *jt);
+  s21::MappedSet<int> mapped(path);
+  ASSERT_EQ(mapped.size(), 1000u);
+  for (int i = -1; i <= 2000; ++i)
+    ASSERT_EQ(mapped.contains(i), set.contains(i));
+  ASSERT_EQ(*mapped.lower_bound(5), 6);
+  ASSERT_EQ(mapped.lower_bound(1999), mapped.end());
+  ASSERT_THROW((s21::MappedMap<int, int>(path)), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(SnapshotTest, MapRoundTrip) {
+  std::string path = ::testing::TempDir() + "s21_map.snap";
+  s21::Map<int, double> map;
+  for (int i = 0; i < 100; ++i) map.insert((i * 37) % 100, i * 0.5);
+  map.save(path);
+  s21::Map<int, double> loaded;
+  loaded.load(path);
+  ASSERT_EQ(loaded.size(), 100u);
+  for (int i = 0; i < 100; ++i) ASSERT_EQ(loaded.at(i), map.at(i));
+  s21::MappedMap<int, double> mapped(path);
+  ASSERT_EQ(mapped.size(), 100u);
+  ASSERT_EQ(mapped.at(74), map.at(74));
+  ASSERT_EQ(mapped.find(100), nullptr);
+  ASSERT_EQ(mapped.key(0), 0);
+  ASSERT_THROW(mapped.at(-1), std::out_of_range);
+  ASSERT_THROW((s21::MappedMap<int, float>(path)), std::runtime_error);
+  ASSERT_THROW(loaded.load(path + ".missing"), std::runtime_error);
+  ASSERT_EQ(loaded.size(), 100u);
+  std::remove(path.c_str());
+}
+
+struct DescendingPairs {
+  using pair = std::pair<int, int>;
+  bool LessThan(const pair &a, const pair &b) const {
+    return a.first > b.first;
+  }
+  bool GreaterThan(const pair &a, const pair &b) const {
+    return a.first < b.first;
+  }
+  bool GreaterOrEquals(const pair &a, const pair &b) const {
+    return a.first <= b.first;
+  }
+  bool NotEquals(const pair &a, const pair &b) const {
+    return a.first != b.first;
+  }
+};
+
+TEST(SnapshotTest, MapCustomComparator) {
+  std::string path = ::testing::TempDir() + "s21_descending.snap";
+  s21::Map<int, int, DescendingPairs> map;
+  for (int i = 0; i < 100; ++i) map.insert((i * 37) % 100, i);
+  map.save(path);
+  s21::MappedMap<int, int, DescendingPairs> mapped(path);
+  ASSERT_EQ(mapped.key(0), 99);
+  for (int i = 0; i < 100; ++i) ASSERT_EQ(mapped.at(i), map.at(i));
+  ASSERT_EQ(mapped.find(100), nullptr);
+  auto frozen = map.freeze();
+  ASSERT_EQ((*frozen.begin()).first, 99);
+  ASSERT_TRUE(frozen.lower_bound(-1) == frozen.end());
+  for (int i = 0; i < 100; ++i) ASSERT_EQ(frozen.at(i), map.at(i));
+  std::remove(path.c_str());
+}
+
+TEST(SnapshotTest, EmptyAndCorrupt) {
+  std::string path = ::testing::TempDir() + "s21_empty.snap";
+  s21::Set<int> empty;
+  empty.save(path);
+  s21::MappedSet<int> mapped(path);
+  ASSERT_EQ(mapped.empty(), true);
+  ASSERT_EQ(mapped.contains(0), false);
+  std::FILE *file = std::fopen(path.c_str(), "r+b");
+  std::fputc('X', file);
+  std::fclose(file);
+  s21::Set<int> set;
+  ASSERT_THROW(set.load(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(SnapshotTest, MappedBoundsChecked) {
+  std::string path = ::testing::TempDir() + "s21_bounds.snap";
+  s21::Map<int, int> map;
+  for (int i = 0; i < 100; ++i) map.insert(i, i);
+  map.save(path);
+  std::FILE *tmp = std::fopen((path + ".tmp").c_str(), "rb");
+  ASSERT_EQ(tmp, nullptr);
+  std::string bytes(1024, '\0');
+  std::FILE *file = std::fopen(path.c_str(), "rb");
+  bytes.resize(std::fread(&bytes[0], 1, bytes.size(), file));
+  std::fclose(file);
+  ASSERT_EQ(bytes.size(), 64u + 448u + 448u);
+  file = std::fopen(path.c_str(), "wb");
+  std::fwrite(bytes.data(), 1, bytes.size() - 64, file);
+  std::fclose(file);
+  ASSERT_THROW((s21::MappedMap<int, int>(path)), std::runtime_error);
+  // 2^62 four-byte keys wrap around to 0 bytes in 64-bit arithmetic.
+  {
+    s21::snapshot::Writer writer(path);
+    writer.Begin(s21::snapshot::kMap, 4, 4, uint64_t(1) << 62);
+    writer.Close();
+  }
+  ASSERT_THROW((s21::MappedMap<int, int>(path)), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(SnapshotTest, LoadChecksCountBeforeReserving) {
+  std::string path = ::testing::TempDir() + "s21_count.snap";
+  const uint64_t kHuge = uint64_t(1) << 40;
+  {
+    s21::snapshot::Writer writer(path);
+    writer.Begin(s21::snapshot::kVector, 4, 0, kHuge);
+    writer.Close();
+  }
+  s21::Vector<int> v = {1, 2};
+  ASSERT_THROW(v.load(path), std::runtime_error);
+  ASSERT_EQ(v.size(), 2u);
+  {
+    s21::snapshot::Writer writer(path);
+    writer.Begin(s21::snapshot::kVector, 0, 0, kHuge);
+    writer.Close();
+  }
+  s21::Vector<std::string> strings;
+  ASSERT_THROW(strings.load(path), std::runtime_error);
+  {
+    s21::snapshot::Writer writer(path);
+    writer.Begin(s21::snapshot::kMap, 4, 8, kHuge);
+    writer.Close();
+  }
+  s21::Map<int, double> map = {{1, 0.5}};
+  ASSERT_THROW(map.load(path), std::runtime_error);
+  ASSERT_EQ(map.size(), 1u);
+  std::remove(path.c_str());
+}
+
+// S21_PERSISTENT_MAP
+TEST(PersistentMapTest, Basics) {
+  std::cout << "\n ============== TEST: S21_PERSISTENT_MAP ============== \n"
+            << std::endl;
+  s21::PersistentMap<int, int> map = {{3, 30}, {1, 10}, {2, 20}};
+  ASSERT_EQ(map.size(), 3u);
+  ASSERT_EQ(map.insert(2, 0), false);
+  ASSERT_EQ(map.at(2), 20);
+  ASSERT_EQ(map.insert_or_assign(2, 22), false);
+  ASSERT_EQ(map.insert_or_assign(4, 40), true);
+  ASSERT_EQ(map.at(2), 22);
+  ASSERT_THROW(map.at(5), std::out_of_range);
+  ASSERT_EQ(map.erase(1), 1u);
+  ASSERT_EQ(map.erase(1), 0u);
+  ASSERT_EQ(map.contains(1), false);
+  int expected = 2;
+  for (auto it = map.begin(); it != map.end(); ++it, ++expected)
+    ASSERT_EQ(it->first, expected);
+  ASSERT_EQ(expected, 5);
+  auto it = map.find(3);
+  ASSERT_EQ((*it).second, 30);
+  ++it;
+  ASSERT_EQ(it->first, 4);
+  ASSERT_EQ(++it, map.end());
+  ASSERT_EQ(map.find(7), map.end());
+  map.clear();
+  ASSERT_EQ(map.empty(), true);
+  ASSERT_EQ(map.begin(), map.end());
+}
+
+TEST(PersistentMapTest, SnapshotIsolation) {
+  s21::PersistentMap<int, std::string> map;
+  std::map<int, std::string> model;
+  for (int i = 0; i < 500; ++i) {
+    map.insert((i * 7) % 500, std::to_string(i));
+    model[(i * 7) % 500] = std::to_string(i);
+  }
+  auto snapshot = map.snapshot();
+  std::map<int, std::string> frozen = model;
+  for (int i = 0; i < 500; i += 3) {
+    map.erase(i);
+    model.erase(i);
+  }
+  for (int i = 1; i < 500; i += 5) {
+    map.insert_or_assign(i, "new");
+    model[i] = "new";
+  }
+  auto check = [](const s21::PersistentMap<int, std::string> &m,
+                  const std::map<int, std::string> &expected) {
+    ASSERT_EQ(m.size(), expected.size());
+    auto jt = expected.begin();
+    for (auto it = m.begin(); it != m.end(); ++it, ++jt) {
+      ASSERT_EQ(it->first, jt->first);
+      ASSERT_EQ(it->second, jt->second);
+    }
+  };
+  check(map, model);
+  check(snapshot, frozen);
+}
+
+TEST(PersistentMapTest, UpdatesCopyOnlyAPath) {
+  namespace ins = s21::instrumentation;
+  s21::PersistentMap<int, int> map;
+  for (int i = 0; i < 1 << 14; ++i) map.insert(i, i);
+  auto snapshot = map.snapshot();
+  ins::Counters before = ins::ThreadCounters();
+  map.insert_or_assign(12345, 0);
+  map.erase(777);
+  ins::Counters after = ins::ThreadCounters();
+  ASSERT_LT(after[ins::tree_node_allocations] -
+                before[ins::tree_node_allocations],
+            200u);
+  ASSERT_EQ(snapshot.at(12345), 12345);
+  ASSERT_EQ(snapshot.contains(777), true);
+}
+
+TEST(PersistentMapTest, ConcurrentReaders) {
+  s21::PersistentMap<int, int> map;
+  for (int i = 0; i < 2000; ++i) map.insert(i, 1);
+  std::vector<std::thread> readers;
+  std::atomic<int> failures{0};
+  for (int r = 0; r < 4; ++r) {
+    auto snapshot = map.snapshot();
+    readers.emplace_back([snapshot, &failures] {
+      for (int round = 0; round < 20; ++round) {
+        size_t sum = 0;
+        for (auto it = snapshot.begin(); it != snapshot.end(); ++it)
+          sum += it->second;
+        if (sum != snapshot.size()) ++failures;
+      }
+    });
+    for (int i = 0; i < 500; ++i) {
+      map.erase(r * 500 + i);
+      map.insert(10000 + r * 500 + i, 1);
+    }
+  }
+  for (auto &reader : readers) reader.join();
+  ASSERT_EQ(failures.load(), 0);
+  ASSERT_EQ(map.size(), 2000u);
+}
+
+// S21_BLOCKING_QUEUE
+TEST(BlockingQueueTest, Basics) {
+  std::cout << "\n ============== TEST: S21_BLOCKING_QUEUE ============== \n"
+            << std::endl;
+  ASSERT_THROW(s21::BlockingQueue<int>(0), std::invalid_argument);
+  s21::BlockingQueue<int> queue(3);
+  ASSERT_EQ(queue.capacity(), 3u);
+  ASSERT_EQ(queue.push(1), true);
+  ASSERT_EQ(queue.push(2), true);
+  ASSERT_EQ(queue.try_push(3), true);
+  ASSERT_EQ(queue.try_push(4), false);
+  ASSERT_EQ(queue.push_for(4, std::chrono::milliseconds(10)), false);
+  int value = 0;
+  ASSERT_EQ(queue.pop(value), true);
+  ASSERT_EQ(value, 1);
+  ASSERT_EQ(queue.push(4), true);
+  s21::Vector<int> batch;
+  ASSERT_EQ(queue.pop_batch(2, batch), 2u);
+  ASSERT_EQ(queue.pop_batch(5, batch), 1u);
+  ASSERT_EQ(batch.size(), 3u);
+  ASSERT_EQ(batch[0], 2);
+  ASSERT_EQ(batch[2], 4);
+  ASSERT_EQ(queue.try_pop(value), false);
+  ASSERT_EQ(queue.pop_for(value, std::chrono::milliseconds(10)), false);
+  ASSERT_EQ(queue.empty(), true);
+  ASSERT_EQ(queue.pop_batch(0, batch), 0u);
+  ASSERT_EQ(batch.size(), 3u);
+}
+
+TEST(BlockingQueueTest, CloseDrainsAndWakes) {
+  s21::BlockingQueue<std::string> queue(4);
+  queue.push("a");
+  queue.push("b");
+  std::thread waiter([&queue] {
+    s21::Vector<std::string> rest;
+    while (queue.pop_batch(1, rest)) {
+    }
+    ASSERT_EQ(rest.size(), 2u);
+    std::string value;
+    ASSERT_EQ(queue.pop(value), false);
+  });
+  queue.close();
+  waiter.join();
+  ASSERT_EQ(queue.closed(), true);
+  ASSERT_EQ(queue.push("c"), false);
+  ASSERT_EQ(queue.try_push("c"), false);
+}
+
+TEST(BlockingQueueTest, ProducersAndConsumers) {
+  const int producers = 3;
+  const int items = 20000;
+  s21::BlockingQueue<int> queue(64);
+  std::atomic<long long> sum{0};
+  std::atomic<int> received{0};
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p)
+    threads.emplace_back([&queue, p] {
+      for (int i = 1; i <= items; ++i) queue.push(p * items + i);
+    });
+  for (int c = 0; c < 2; ++c)
+    threads.emplace_back([&queue, &sum, &received, c] {
+      s21::Vector<int> batch;
+      int value = 0;
+      while (c ? queue.pop(value) : queue.pop_batch(16, batch) > 0) {
+        if (c) {
+          sum += value;
+          ++received;
+        }
+      }
+      for (size_t i = 0; i < batch.size(); ++i) sum += batch[i];
+      received += (int)batch.size();
+    });
+  for (int p = 0; p < producers; ++p) threads[p].join();
+  queue.close();
+  for (size_t t = producers; t < threads.size(); ++t) threads[t].join();
+  long long n = (long long)producers * items;
+  ASSERT_EQ(received.load(), n);
+  ASSERT_EQ(sum.load(), n * (n + 1) / 2);
+}
+
+// S21_CHANNEL
+#ifdef __cpp_impl_coroutine
+s21::coro::Task SendRange(s21::Channel<int> *channel, int from, int to,
+                          bool close) {
+  for (int i = from; i <= to; ++i) co_await channel->send(i);
+  if (close) channel->close();
+}
+
+s21::coro::Task SumAll(s21::Channel<int> *channel, long long *sum,
+                       int *count) {
+  while (std::optional<int> value = co_await channel->receive()) {
+    *sum += *value;
+    ++*count;
+  }
+}
+
+s21::coro::Task SendOnce(s21::Channel<int> *channel, int value, bool *sent) {
+  *sent = co_await channel->send(value);
+}
+
+s21::coro::Task ReceiveOnce(s21::Channel<int> *channel,
+                            std::optional<int> *value) {
+  *value = co_await channel->receive();
+}
+
+TEST(ChannelTest, SingleThread) {
+  std::cout << "\n ============== TEST: S21_CHANNEL ============== \n"
+            << std::endl;
+  s21::coro::SingleThreadExecutor executor;
+  s21::Channel<int> channel(4);
+  long long sum = 0;
+  int count = 0;
+  executor.Spawn(SumAll(&channel, &sum, &count));
+  executor.Spawn(SendRange(&channel, 1, 100, true));
+  ASSERT_EQ(executor.pending(), 2u);
+  executor.Run();
+  ASSERT_EQ(executor.pending(), 0u);
+  ASSERT_EQ(count, 100);
+  ASSERT_EQ(sum, 5050);
+  ASSERT_EQ(channel.closed(), true);
+}
+
+TEST(ChannelTest, RendezvousAndClose) {
+  s21::coro::SingleThreadExecutor executor;
+  s21::Channel<int> channel(0);
+  ASSERT_EQ(channel.capacity(), 0u);
+  bool sent = false;
+  std::optional<int> value;
+  executor.Spawn(SendOnce(&channel, 7, &sent));
+  executor.Run();
+  ASSERT_EQ(executor.pending(), 1u);
+  executor.Spawn(ReceiveOnce(&channel, &value));
+  executor.Run();
+  ASSERT_EQ(sent, true);
+  ASSERT_EQ(value, 7);
+  executor.Spawn(ReceiveOnce(&channel, &value));
+  executor.Spawn(SendOnce(&channel, 8, &sent));
+  executor.Spawn(SendOnce(&channel, 9, &sent));
+  executor.Run();
+  ASSERT_EQ(value, 8);
+  ASSERT_EQ(executor.pending(), 1u);
+  channel.close();
+  executor.Run();
+  ASSERT_EQ(sent, false);
+  executor.Spawn(ReceiveOnce(&channel, &value));
+  executor.Run();
+  ASSERT_EQ(value, std::nullopt);
+  ASSERT_EQ(executor.pending(), 0u);
+}
+
+TEST(ChannelTest, BufferedValuesSurviveClose) {
+  s21::coro::SingleThreadExecutor executor;
+  s21::Channel<int> channel(8);
+  executor.Spawn(SendRange(&channel, 1, 5, true));
+  executor.Run();
+  ASSERT_EQ(channel.size(), 5u);
+  long long sum = 0;
+  int count = 0;
+  executor.Spawn(SumAll(&channel, &sum, &count));
+  executor.Run();
+  ASSERT_EQ(count, 5);
+  ASSERT_EQ(sum, 15);
+}
+
+TEST(ChannelTest, ThreadPoolFanIn) {
+  const int producers = 4;
+  const int items = 2000;
+  s21::Channel<int> channel(16);
+  long long sum = 0;
+  int count = 0;
+  {
+    s21::coro::ThreadPoolExecutor pool(3);
+    pool.Spawn(SumAll(&channel, &sum, &count));
+    for (int p = 0; p < producers; ++p)
+      pool.Spawn(SendRange(&channel, p * items + 1, (p + 1) * items, false));
+    while (pool.pending() > 1) std::this_thread::yield();
+    channel.close();
+    pool.Wait();
+  }
+  long long n = (long long)producers * items;
+  ASSERT_EQ(count, n);
+  ASSERT_EQ(sum, n * (n + 1) / 2);
+}
+#endif  // __cpp_impl_coroutine
+
+// S21_LOCK_FREE_STACK
+TEST(LockFreeStackTest, Basics) {
+  std::cout << "\n ============== TEST: S21_LOCK_FREE_STACK ============== \n"
+            << std::endl;
+  s21::LockFreeStack<std::string> stack;
+  std::string value;
+  ASSERT_EQ(stack.empty(), true);
+  ASSERT_EQ(stack.try_pop(value), false);
+  stack.push("a");
+  stack.push(std::string(100, 'b'));
+  ASSERT_EQ(stack.empty(), false);
+  ASSERT_EQ(stack.try_pop(value), true);
+  ASSERT_EQ(value, std::string(100, 'b'));
+  stack.push("c");
+  ASSERT_EQ(stack.try_pop(value), true);
+  ASSERT_EQ(value, "c");
+  ASSERT_EQ(stack.try_pop(value), true);
+  ASSERT_EQ(value, "a");
+  ASSERT_EQ(stack.empty(), true);
+  stack.push("left for the destructor");
+}
+
+TEST(LockFreeStackTest, Stress) {
+  const int threads = 8;
+  const int per_thread = 20000;
+  s21::LockFreeStack<int> stack;
+  std::vector<std::atomic<int>> seen(threads * per_thread);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t)
+    workers.emplace_back([&stack, &seen, t] {
+      int value;
+      for (int i = 0; i < per_thread; ++i) {
+        stack.push(t * per_thread + i);
+        if (i % 3 != 2 && stack.try_pop(value)) ++seen[value];
+      }
+    });
+  for (auto &worker : workers) worker.join();
+  int value;
+  while (stack.try_pop(value)) ++seen[value];
+  for (size_t i = 0; i < seen.size(); ++i) ASSERT_EQ(seen[i].load(), 1);
+}
+
+// S21_THREAD_POOL
+TEST(WorkStealingDequeTest, OwnerAndThief) {
+  std::cout << "\n ============== TEST: S21_THREAD_POOL ============== \n"
+            << std::endl;
+  s21::WorkStealingDeque<int> deque(2);
+  int value = 0;
+  ASSERT_EQ(deque.pop(value), false);
+  ASSERT_EQ(deque.steal(value), false);
+  for (int i = 0; i < 100; ++i) deque.push(i);
+  ASSERT_EQ(deque.size(), 100u);
+  ASSERT_EQ(deque.steal(value), true);
+  ASSERT_EQ(value, 0);
+  ASSERT_EQ(deque.pop(value), true);
+  ASSERT_EQ(value, 99);
+  while (deque.pop(value)) {
+  }
+  ASSERT_EQ(value, 1);
+  ASSERT_EQ(deque.empty(), true);
+}
+
+TEST(WorkStealingDequeTest, ConcurrentSteals) {
+  const int items = 100000;
+  s21::WorkStealingDeque<int> deque;
+  std::vector<std::atomic<int>> seen(items);
+  std::atomic<bool> done{false};
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < 3; ++t)
+    thieves.emplace_back([&] {
+      int value;
+      while (!done.load() || !deque.empty())
+        if (deque.steal(value)) ++seen[value];
+    });
+  int value;
+  for (int i = 0; i < items; ++i) {
+    deque.push(i);
+    if (i % 2 && deque.pop(value)) ++seen[value];
+  }
+  while (deque.pop(value)) ++seen[value];
+  done = true;
+  for (auto &thief : thieves) thief.join();
+  for (int i = 0; i < items; ++i) ASSERT_EQ(seen[i].load(), 1);
+}
+
+TEST(ThreadPoolTest, SubmitAndWait) {
+  s21::ThreadPool pool(3);
+  ASSERT_EQ(pool.size(), 3u);
+  std::atomic<int> count{0};
+  for (int i = 0; i < 1000; ++i) pool.submit([&count] { ++count; });
+  pool.wait();
+  ASSERT_EQ(count.load(), 1000);
+  for (int i = 0; i < 10; ++i)
+    pool.submit([&pool, &count] {
+      for (int j = 0; j < 10; ++j) pool.submit([&count] { ++count; });
+    });
+  pool.wait();
+  ASSERT_EQ(count.load(), 1100);
+}
+
+TEST(ThreadPoolTest, ParallelFor) {
+  s21::ThreadPool pool(4);
+  s21::Vector<int> v(100000);
+  std::iota(v.begin(), v.end(), 0);
+  std::atomic<long long> sum{0};
+  pool.parallel_for(0, v.size(), 1000, [&](size_t lo, size_t hi) {
+    ASSERT_LE(hi - lo, 1000u);
+    long long part = 0;
+    for (size_t i = lo; i < hi; ++i) part += v[i];
+    sum += part;
+  });
+  ASSERT_EQ(sum.load(), 99999LL * 100000 / 2);
+  std::atomic<int> cells{0};
+  pool.parallel_for(0, 8, 1, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i)
+      pool.parallel_for(0, 100, 7, [&](size_t a, size_t b) {
+        cells += (int)(b - a);
+      });
+  });
+  ASSERT_EQ(cells.load(), 800);
+  pool.parallel_for(5, 5, 1, [](size_t, size_t) { FAIL(); });
+}
+
+TEST(ThreadPoolTest, ExternalWaiterSleeps) {
+  s21::ThreadPool pool(1);
+  pool.submit(
+      [] { std::this_thread::sleep_for(std::chrono::milliseconds(200)); });
+  timespec before, after;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &before);
+  pool.wait();
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &after);
+  double busy = (double)(after.tv_sec - before.tv_sec) +
+                (double)(after.tv_nsec - before.tv_nsec) * 1e-9;
+  ASSERT_LT(busy, 0.05);
+}
+
+TEST(ThreadPoolTest, NestedAlgorithmsShareThePool) {
+  s21::Vector<int> outer(1 << 16);
+  s21::Vector<int> inner(1 << 16);
+  for (size_t i = 0; i < inner.size(); ++i) inner[i] = (int)i % 3;
+  std::atomic<long long> total{0};
+  s21::for_each(s21::execution::parallel_policy{4}, outer, [&](int &x) {
+    x = 1;
+    if (&x - outer.data() < 4)
+      total += s21::reduce(s21::execution::parallel_policy{4}, inner, 0LL);
+  });
+  ASSERT_EQ(total.load(), 4 * 65535LL);
+  ASSERT_EQ(s21::reduce(outer, 0), 1 << 16);
+  ASSERT_GE(s21::parallel::Pool().size(), 1u);
+}
+
+// S21_UNROLLED_LIST
+template <class T, size_t B>
+std::list<T> ToStd(const s21::UnrolledList<T, B> &list) {
+  std::list<T> out;
+  for (auto it = list.cbegin(); it != list.cend(); ++it) out.push_back(*it);
+  return out;
+}
+
+TEST(UnrolledListTest, MatchesStdList) {
+  std::cout << "\n ============== TEST: S21_UNROLLED_LIST ============== \n"
+            << std::endl;
+  s21::UnrolledList<int, 4> list;
+  std::list<int> expected;
+  uint32_t state = 7;
+  for (int i = 0; i < 5000; ++i) {
+    state = state * 1664525u + 1013904223u;
+    size_t at = expected.empty() ? 0 : (state >> 8) % (expected.size() + 1);
+    auto it = list.begin() + (int)at;
+    auto std_it = std::next(expected.begin(), at);
+    if (state % 3 || expected.empty() || at == expected.size()) {
+      auto inserted = list.insert(it, i);
+      ASSERT_EQ(*inserted, i);
+      expected.insert(std_it, i);
+    } else {
+      list.erase(it);
+      expected.erase(std_it);
+    }
+    ASSERT_EQ(list.size(), expected.size());
+  }
+  ASSERT_EQ(ToStd(list), expected);
+  std::list<int> backwards;
+  for (auto it = list.end(); it != list.begin();) backwards.push_front(*--it);
+  ASSERT_EQ(backwards, expected);
+  ASSERT_EQ(list.front(), expected.front());
+  ASSERT_EQ(list.back(), expected.back());
+}
+
+TEST(UnrolledListTest, IteratorsInOtherBlocksStayValid) {
+  s21::UnrolledList<int, 4> list;
+  for (int i = 0; i < 16; ++i) list.push_back(i);
+  auto last = list.begin() + 14;
+  auto first = list.begin() + 1;
+  for (int i = 0; i < 5; ++i) list.insert(list.begin() + 6, 100 + i);
+  ASSERT_EQ(*first, 1);
+  ASSERT_EQ(*last, 14);
+  list.erase(list.begin() + 6);
+  ASSERT_EQ(*first, 1);
+  ASSERT_EQ(*last, 14);
+}
+
+TEST(UnrolledListTest, PushPopAndCopy) {
+  s21::UnrolledList<std::string, 3> list = {"b", "c"};
+  list.push_front("a");
+  list.push_back("d");
+  list.pop_front();
+  list.pop_back();
+  s21::UnrolledList<std::string, 3> copy(list);
+  s21::UnrolledList<std::string, 3> moved(std::move(list));
+  ASSERT_EQ(ToStd(copy), (std::list<std::string>{"b", "c"}));
+  ASSERT_EQ(ToStd(moved), (std::list<std::string>{"b", "c"}));
+  ASSERT_EQ(list.empty(), true);
+  copy = moved;
+  copy.clear();
+  ASSERT_EQ(copy.size(), 0u);
+  ASSERT_EQ(moved.size(), 2u);
+  s21::UnrolledList<int> sized(5);
+  ASSERT_EQ(ToStd(sized), std::list<int>(5));
+}
+
+TEST(UnrolledListTest, SpliceMidBlock) {
+  s21::UnrolledList<int, 4> list = {1, 2, 5, 6};
+  s21::UnrolledList<int, 4> other = {3, 4};
+  auto kept = other.begin() + 1;
+  list.splice(list.cbegin() + 2, other);
+  ASSERT_EQ(ToStd(list), (std::list<int>{1, 2, 3, 4, 5, 6}));
+  ASSERT_EQ(other.empty(), true);
+  ASSERT_EQ(*kept, 4);
+  list.splice(list.cend(), other);
+  ASSERT_EQ(list.size(), 6u);
+  s21::UnrolledList<int, 4> tail = {7, 8};
+  list.splice(list.cend(), tail);
+  ASSERT_EQ(list.back(), 8);
+}
+
+TEST(UnrolledListTest, MergeReverseUniqueSort) {
+  s21::UnrolledList<int, 4> a = {1, 3, 5, 7, 9, 11};
+  s21::UnrolledList<int, 4> b = {2, 3, 4, 10};
+  a.merge(b);
+  ASSERT_EQ(ToStd(a), (std::list<int>{1, 2, 3, 3, 4, 5, 7, 9, 10, 11}));
+  ASSERT_EQ(b.size(), 0u);
+  a.unique();
+  ASSERT_EQ(ToStd(a), (std::list<int>{1, 2, 3, 4, 5, 7, 9, 10, 11}));
+  a.reverse();
+  ASSERT_EQ(ToStd(a), (std::list<int>{11, 10, 9, 7, 5, 4, 3, 2, 1}));
+  a.sort();
+  ASSERT_EQ(ToStd(a), (std::list<int>{1, 2, 3, 4, 5, 7, 9, 10, 11}));
+  s21::UnrolledList<int, 4> same = {2, 2, 2, 2, 2, 2, 2, 2, 2};
+  same.unique();
+  ASSERT_EQ(ToStd(same), (std::list<int>{2}));
+}
+
+// S21_INTRUSIVE
+struct Timer {
+  int deadline = 0;
+  int id = 0;
+  s21::ListHook by_age;
+  s21::SetHook by_deadline;
+  s21::SetHook by_id;
+
+  bool operator<(const Timer &other) const {
+    return deadline < other.deadline;
+  }
+};
+
+struct TimerIdComparator {
+  bool LessThan(const Timer &a, const Timer &b) const { return a.id < b.id; }
+};
+
+using TimerList = s21::IntrusiveList<Timer, &Timer::by_age>;
+using TimersByDeadline = s21::IntrusiveSet<Timer, &Timer::by_deadline>;
+using TimersById =
+    s21::IntrusiveSet<Timer, &Timer::by_id, TimerIdComparator>;
+
+TEST(IntrusiveTest, ListLinksObjectsInPlace) {
+  std::cout << "\n ============== TEST: S21_INTRUSIVE ============== \n"
+            << std::endl;
+  std::vector<Timer> timers(5);
+  for (int i = 0; i < 5; ++i) timers[i].id = i;
+  TimerList list;
+  for (auto &timer : timers) list.push_back(timer);
+  ASSERT_EQ(list.size(), 5u);
+  ASSERT_EQ(&list.front(), &timers[0]);
+  ASSERT_EQ(&list.back(), &timers[4]);
+  list.erase(timers[2]);
+  ASSERT_EQ(timers[2].by_age.is_linked(), false);
+  list.pop_front();
+  list.push_front(timers[2]);
+  std::vector<int> ids;
+  for (auto it = list.begin(); it != list.end(); ++it) ids.push_back(it->id);
+  ASSERT_EQ(ids, (std::vector<int>{2, 1, 3, 4}));
+  list.reverse();
+  ids.clear();
+  for (auto it = list.cbegin(); it != list.cend(); ++it) ids.push_back(it->id);
+  ASSERT_EQ(ids, (std::vector<int>{4, 3, 1, 2}));
+
+  TimerList other;
+  other.push_back(timers[0]);
+  list.splice(list.cbegin(), other);
+  ASSERT_EQ(other.empty(), true);
+  ASSERT_EQ(list.front().id, 0);
+  ASSERT_EQ(list.size(), 5u);
+  list.clear();
+  ASSERT_EQ(timers[3].by_age.is_linked(), false);
+}
+
+TEST(IntrusiveTest, SetMatchesStdSet) {
+  const int n = 2000;
+  std::vector<Timer> timers(n);
+  TimersByDeadline set;
+  std::set<int> expected;
+  uint32_t state = 5;
+  for (int i = 0; i < n; ++i) {
+    state = state * 1664525u + 1013904223u;
+    timers[i].deadline = (int)(state >> 20);
+    timers[i].id = i;
+    bool inserted = set.insert(timers[i]).second;
+    ASSERT_EQ(inserted, expected.insert(timers[i].deadline).second);
+    ASSERT_EQ(timers[i].by_deadline.is_linked(), inserted);
+  }
+  for (int i = 0; i < n; i += 3) {
+    if (!timers[i].by_deadline.is_linked()) continue;
+    set.erase(timers[i]);
+    expected.erase(timers[i].deadline);
+  }
+  ASSERT_EQ(set.size(), expected.size());
+  std::vector<int> walked;
+  for (auto it = set.begin(); it != set.end(); ++it)
+    walked.push_back(it->deadline);
+  ASSERT_EQ(walked, std::vector<int>(expected.begin(), expected.end()));
+  std::vector<int> backwards;
+  for (auto it = set.end(); it != set.begin();)
+    backwards.push_back((--it)->deadline);
+  ASSERT_EQ(backwards, std::vector<int>(expected.rbegin(), expected.rend()));
+  Timer probe;
+  for (int deadline = 0; deadline < 4096; deadline += 7) {
+    probe.deadline = deadline;
+    ASSERT_EQ(set.contains(probe), expected.count(deadline) == 1);
+    auto it = set.lower_bound(probe);
+    auto std_it = expected.lower_bound(deadline);
+    if (std_it == expected.end())
+      ASSERT_EQ(it == set.end(), true);
+    else
+      ASSERT_EQ(it->deadline, *std_it);
+  }
+  set.clear();
+  ASSERT_EQ(set.empty(), true);
+  for (auto &timer : timers) ASSERT_EQ(timer.by_deadline.is_linked(), false);
+}
+
+TEST(IntrusiveTest, ObjectInSeveralContainers) {
+  std::vector<Timer> timers(100);
+  TimerList list;
+  TimersByDeadline by_deadline;
+  TimersById by_id;
+  for (int i = 0; i < 100; ++i) {
+    timers[i].id = 99 - i;
+    timers[i].deadline = i * 10;
+    list.push_back(timers[i]);
+    by_deadline.insert(timers[i]);
+    by_id.insert(timers[i]);
+  }
+  ASSERT_EQ(&*by_deadline.begin(), &timers[0]);
+  ASSERT_EQ(&*by_id.begin(), &timers[99]);
+  by_id.erase(timers[99]);
+  ASSERT_EQ(&*by_id.begin(), &timers[98]);
+  ASSERT_EQ(by_deadline.size(), 100u);
+  ASSERT_EQ(list.size(), 100u);
+  Timer copy = timers[0];
+  ASSERT_EQ(copy.by_age.is_linked(), false);
+  ASSERT_EQ(copy.by_deadline.is_linked(), false);
+  Timer key;
+  key.id = 42;
+  ASSERT_EQ(by_id.find(key)->deadline, 570);
+}
+
+// S21_CACHE
+TEST(CacheTest, LruEvictsLeastRecentlyUsed) {
+  std::cout << "\n ============== TEST: S21_CACHE ============== \n"
+            << std::endl;
+  s21::LruCache<int, std::string> cache(3);
+  std::vector<std::pair<int, std::string>> evicted;
+  cache.on_evict([&evicted](const int &key, std::string &value) {
+    evicted.emplace_back(key, value);
+  });
+  cache.put(1, "one");
+  cache.put(2, "two");
+  cache.put(3, "three");
+  ASSERT_EQ(*cache.get(1), "one");
+  cache.put(4, "four");
+  ASSERT_EQ(evicted.size(), 1u);
+  ASSERT_EQ(evicted[0].first, 2);
+  ASSERT_EQ(evicted[0].second, "two");
+  ASSERT_EQ(cache.get(2), nullptr);
+  cache.put(3, "drei");
+  cache.put(5, "five");
+  ASSERT_EQ(evicted.back().first, 1);
+  ASSERT_EQ(*cache.get(3), "drei");
+  ASSERT_EQ(cache.size(), 3u);
+  ASSERT_EQ(cache.hits(), 2u);
+  ASSERT_EQ(cache.misses(), 1u);
+  ASSERT_EQ(cache.erase(4), true);
+  ASSERT_EQ(cache.erase(4), false);
+  ASSERT_EQ(cache.contains(4), false);
+  cache.put(6, "six");
+  ASSERT_EQ(evicted.size(), 2u);
+  cache.clear();
+  ASSERT_EQ(cache.empty(), true);
+  ASSERT_THROW((s21::LruCache<int, int>(0)), std::out_of_range);
+}
+
+TEST(CacheTest, ClockGivesReferencedEntriesASecondChance) {
+  s21::ClockCache<int, int> cache(3);
+  int last_evicted = -1;
+  cache.on_evict([&last_evicted](const int &key, int &) {
+    last_evicted = key;
+  });
+  cache.put(1, 10);
+  cache.put(2, 20);
+  cache.put(3, 30);
+  ASSERT_EQ(*cache.get(1), 10);
+  cache.put(4, 40);
+  ASSERT_EQ(last_evicted, 2);
+  ASSERT_EQ(cache.contains(1), true);
+  cache.put(5, 50);
+  ASSERT_EQ(last_evicted, 3);
+  ASSERT_EQ(cache.erase(1), true);
+  cache.put(6, 60);
+  ASSERT_EQ(cache.size(), 3u);
+  ASSERT_EQ(last_evicted, 3);
+}
+
+template <class Cache>
+void CheckCacheAgainstModel() {
+  const size_t capacity = 64;
+  Cache cache(capacity);
+  std::map<int, int> model;
+  size_t evictions = 0;
+  cache.on_evict([&](const int &key, int &value) {
+    ASSERT_EQ(model.at(key), value);
+    model.erase(key);
+    ++evictions;
+  });
+  uint32_t state = 3;
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 1664525u + 1013904223u;
+    int key = (int)((state >> 16) % 200);
+    if (state % 7 == 0) {
+      ASSERT_EQ(cache.erase(key), model.erase(key) == 1);
+    } else if (state % 2) {
+      int *value = cache.get(key);
+      ASSERT_EQ(value != nullptr, model.count(key) == 1);
+      if (value) {
+        ASSERT_EQ(*value, model[key]);
+      }
+    } else {
+      cache.put(key, i);
+      model[key] = i;
+    }
+    ASSERT_EQ(cache.size(), model.size());
+    ASSERT_LE(cache.size(), capacity);
+  }
+  ASSERT_GT(evictions, 0u);
+}
+
+TEST(CacheTest, MatchesModel) {
+  CheckCacheAgainstModel<s21::LruCache<int, int>>();
+  CheckCacheAgainstModel<s21::ClockCache<int, int>>();
+}
+
+// S21_FIND_MANY
+TEST(FindManyTest, SetMatchesContains) {
+  std::cout << "\n ============== TEST: S21_FIND_MANY ============== \n"
+            << std::endl;
+  s21::Set<int> set;
+  std::set<int> expected;
+  uint32_t state = 11;
+  for (int i = 0; i < 3000; ++i) {
+    state = state * 1664525u + 1013904223u;
+    int key = (int)(state >> 20);
+    set.insert(key);
+    expected.insert(key);
+  }
+  s21::Vector<int> keys;
+  for (int key = -5; key < 5000; key += 3) keys.push_back(key);
+  s21::Vector<bool> present;
+  s21::Vector<s21::Set<int>::iterator> found;
+  size_t hits = set.contains_many(keys, present);
+  set.find_many(keys, found);
+  ASSERT_EQ(present.size(), keys.size());
+  ASSERT_EQ(found.size(), keys.size());
+  size_t expected_hits = 0;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    bool in = expected.count(keys[i]) == 1;
+    expected_hits += in;
+    ASSERT_EQ(present[i], in);
+    if (in)
+      ASSERT_EQ(*found[i], keys[i]);
+    else
+      ASSERT_EQ(found[i] == set.end(), true);
+  }
+  ASSERT_EQ(hits, expected_hits);
+}
+
+TEST(FindManyTest, MapAndEdgeCases) {
+  s21::Map<int, long> map;
+  s21::Vector<int> keys = {1, 2, 3};
+  s21::Vector<bool> present;
+  ASSERT_EQ(map.contains_many(keys, present), 0u);
+  ASSERT_EQ(present[0] || present[1] || present[2], false);
+  for (int i = 0; i < 100; i += 2) map.insert(i, i * 10L);
+  keys.clear();
+  for (int i = 0; i < 100; ++i) keys.push_back(99 - i);
+  s21::Vector<s21::Map<int, long>::iterator> found;
+  map.find_many(keys, found);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (keys[i] % 2 == 0)
+      ASSERT_EQ((*found[i]).second, keys[i] * 10L);
+    else
+      ASSERT_EQ(found[i] == map.end(), true);
+  }
+  ASSERT_EQ(map.contains_many(keys, present), 50u);
+  s21::Vector<int> none;
+  map.find_many(none, found);
+  ASSERT_EQ(found.size(), 0u);
+}
+
+// S21_BLOOM
+TEST(BloomTest, FilterHasNoFalseNegatives) {
+  std::cout << "\n ============== TEST: S21_BLOOM ============== \n"
+            << std::endl;
+  const uint64_t n = 20000;
+  s21::BloomFilter filter(n);
+  ASSERT_EQ(filter.enabled(), true);
+  for (uint64_t i = 0; i < n; ++i) filter.Insert(s21::BloomHash(i));
+  for (uint64_t i = 0; i < n; ++i)
+    ASSERT_EQ(filter.MayContain(s21::BloomHash(i)), true);
+  size_t passed = 0;
+  for (uint64_t i = n; i < 11 * n; ++i) {
+    bool scalar =
+        filter.MayContain(s21::BloomHash(i), s21::simd::Level::kScalar);
+    ASSERT_EQ(filter.MayContain(s21::BloomHash(i)), scalar);
+    passed += scalar;
+  }
+  ASSERT_LT(passed, 10 * n / 40);
+  ASSERT_EQ(s21::BloomFilter().enabled(), false);
+}
+
+TEST(BloomTest, SetStaysCorrectThroughUpdates) {
+  s21::Set<int> set;
+  std::set<int> expected;
+  set.enable_bloom(true);
+  ASSERT_EQ(set.bloom_enabled(), true);
+  uint32_t state = 13;
+  for (int round = 0; round < 30000; ++round) {
+    state = state * 1664525u + 1013904223u;
+    int key = (int)((state >> 12) % 5000);
+    if (state % 3) {
+      set.insert(key);
+      expected.insert(key);
+    } else {
+      auto it = set.find(key);
+      ASSERT_EQ(it != set.end(), expected.count(key) == 1);
+      if (it != set.end()) set.erase(it);
+      expected.erase(key);
+    }
+    ASSERT_EQ(set.contains(key), expected.count(key) == 1);
+  }
+  for (int key = 0; key < 5000; ++key)
+    ASSERT_EQ(set.contains(key), expected.count(key) == 1);
+  set.erase_range(1000, 4000);
+  auto upper = set.split(2500);
+  ASSERT_EQ(upper.bloom_enabled(), true);
+  ASSERT_EQ(upper.contains(4500), expected.count(4500) == 1);
+  set.join(upper);
+  for (int key = 0; key < 5000; ++key)
+    ASSERT_EQ(set.contains(key),
+              expected.count(key) == 1 && (key < 1000 || key >= 4000));
+  set.clear();
+  ASSERT_EQ(set.contains(1), false);
+  set.insert(1);
+  ASSERT_EQ(set.contains(1), true);
+  set.enable_bloom(false);
+  ASSERT_EQ(set.contains(1), true);
+}
+
+TEST(BloomTest, MapAndMoves) {
+  s21::Map<long, int> map;
+  map.enable_bloom(true);
+  for (long i = 0; i < 3000; ++i) map.insert(i * 7, (int)i);
+  s21::Map<long, int> moved(std::move(map));
+  ASSERT_EQ(moved.bloom_enabled(), true);
+  for (long i = 0; i < 3000 * 7; ++i)
+    ASSERT_EQ(moved.contains(i), i % 7 == 0);
+  s21::Map<long, int> copy(moved);
+  ASSERT_EQ(copy.bloom_enabled(), false);
+  ASSERT_EQ(copy.contains(21), true);
+}
+
+TEST(BloomTest, OnlyForDefaultComparators) {
+  using Pair = std::pair<std::string, int>;
+  using Pairs = s21::PairComparator<std::string, int>;
+  using Ints = s21::SingleComparator<int>;
+  static_assert(s21::IsDefaultComparator<Pair, Pairs>::value, "");
+  static_assert(s21::IsDefaultComparator<int, Ints>::value, "");
+  static_assert(!s21::IsDefaultComparator<Pair, CaseInsensitivePairs>::value,
+                "");
+  // Maps that cannot enable the filter still split and load.
+  std::string path = ::testing::TempDir() + "s21_no_bloom.snap";
+  s21::Map<std::string, int, CaseInsensitivePairs> map;
+  map.insert("Apple", 1);
+  map.insert("pear", 2);
+  map.save(path);
+  s21::Map<std::string, int, CaseInsensitivePairs> loaded;
+  loaded.load(path);
+  ASSERT_EQ(loaded.bloom_enabled(), false);
+  ASSERT_EQ(loaded.contains("APPLE"), true);
+  auto upper = loaded.split("B");
+  ASSERT_EQ(upper.contains("PEAR"), true);
+  std::remove(path.c_str());
+}
+
+// S21_HETEROGENEOUS
+TEST(HeterogeneousTest, SetLooksUpStringView) {
+  std::cout << "\n ============== TEST: S21_HETEROGENEOUS ============== \n"
+            << std::endl;
+  s21::Set<std::string> set = {"pear", "apple", "plum", "fig"};
+  std::string_view plum = "plum";
+  ASSERT_EQ(*set.find(plum), "plum");
+  ASSERT_EQ(set.find(std::string_view("kiwi")) == set.end(), true);
+  ASSERT_EQ(set.contains("apple"), true);
+  ASSERT_EQ(set.contains(std::string_view("app")), false);
+  ASSERT_EQ(set.count(plum.substr(0, 2)), 0u);
+  ASSERT_EQ(*set.lower_bound(std::string_view("g")), "pear");
+  ASSERT_EQ(set.lower_bound("q") == set.end(), true);
+  ASSERT_EQ(*set.find(std::string("fig")), "fig");
+}
+
+TEST(HeterogeneousTest, MapLooksUpStringView) {
+  s21::Map<std::string, int> map;
+  for (int i = 0; i < 200; ++i) map[std::to_string(i * 3)] = i;
+  std::string_view key = "150";
+  ASSERT_EQ(map.at(key), 50);
+  ASSERT_EQ(map.at("3"), 1);
+  ASSERT_THROW(map.at(std::string_view("151")), std::out_of_range);
+  ASSERT_EQ(map.contains(key), true);
+  ASSERT_EQ(map.contains("1"), false);
+  ASSERT_EQ(map.count(std::string_view("0")), 1u);
+  ASSERT_EQ((*map.find(key)).second, 50);
+  ASSERT_EQ(map.find("2") == map.end(), true);
+  ASSERT_EQ((*map.lower_bound(std::string_view("151"))).first, "153");
+  map.at(key) = 7;
+  ASSERT_EQ(map[std::string(key)], 7);
+  ASSERT_EQ(map["new"], 0);
+  ASSERT_EQ(map.size(), 201u);
+  map.enable_bloom(true);
+  for (int i = 0; i < 600; ++i)
+    ASSERT_EQ(map.contains(std::to_string(i)), i % 3 == 0 || i == 150);
+  ASSERT_EQ(map.contains(std::string_view("new")), true);
+  ASSERT_EQ(map.contains("absent"), false);
+}
+
+TEST(HeterogeneousTest, NumericProbesConvertToKey) {
+  static_assert(!s21::IsKeyProbe<size_t, int>::value, "");
+  static_assert(s21::IsKeyProbe<std::string, const char *>::value, "");
+  s21::Set<size_t> sizes = {1, 2, 3};
+  ASSERT_EQ(sizes.contains(3), true);
+  ASSERT_EQ(sizes.count(4), 0u);
+  ASSERT_EQ(*sizes.lower_bound(2), 2u);
+  s21::Map<unsigned, int> map = {{1, 10}, {2, 20}};
+  ASSERT_EQ(map.at(2), 20);
+  ASSERT_EQ(map.contains(1), true);
+  ASSERT_EQ((*map.find(1)).second, 10);
+  s21::Set<int> ints = {1};
+  ASSERT_EQ(ints.contains(1.5), true);
+}
+
+TEST(HeterogeneousTest, MapKeyedByIntHoldsStrings) {
+  s21::Map<int, std::string> map;
+  for (int i = 0; i < 100; ++i) map.insert(i, std::string(40, 'a' + i % 26));
+  ASSERT_EQ(map.at(27), std::string(40, 'b'));
+  ASSERT_THROW(map.at(100), std::out_of_range);
+  ASSERT_EQ(map[99], std::string(40, 'v'));
+  map[100] = "x";
+  ASSERT_EQ(map.size(), 101u);
+  ASSERT_EQ(map.contains(100), true);
+  ASSERT_EQ(map.count(101), 0u);
+  ASSERT_EQ((*map.lower_bound(50)).first, 50);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();